@@ -0,0 +1,87 @@
+#include "physics_benchmark.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+using namespace JE;
+
+// every allocation of the process goes through here
+void* operator new(size_t size)
+{
+	++PhysicsBenchmark::allocations;
+
+	if (void* p = malloc(size ? size : 1))
+		return p;
+
+	throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+	free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+	free(p);
+}
+
+// usage: benchmark [-bodies n] [-steps n] [-seed n] [-threads n] [-static ratio] [-bullets ratio] [-circles ratio] [-frames] [-tree] [-tunnel] [-speed n] [-stack] [-height n] [-nowarm] [-sat] [-json file]
+int main(int argc, char* args[]) {
+
+	PhysicsBenchmark::Config config;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		bool hasValue = i + 1 < argc;
+
+		if (!strcmp(args[i], "-bodies") && hasValue)
+			config.bodies = static_cast<unsigned>(atoi(args[++i]));
+		else if (!strcmp(args[i], "-steps") && hasValue)
+			config.steps = static_cast<unsigned>(atoi(args[++i]));
+		else if (!strcmp(args[i], "-seed") && hasValue)
+			config.seed = static_cast<unsigned>(atoi(args[++i]));
+		else if (!strcmp(args[i], "-threads") && hasValue)
+			config.threads = static_cast<unsigned>(atoi(args[++i]));
+		else if (!strcmp(args[i], "-static") && hasValue)
+			config.staticRatio = static_cast<float>(atof(args[++i]));
+		else if (!strcmp(args[i], "-bullets") && hasValue)
+			config.bulletRatio = static_cast<float>(atof(args[++i]));
+		else if (!strcmp(args[i], "-circles") && hasValue)
+			config.circleRatio = static_cast<float>(atof(args[++i]));
+		else if (!strcmp(args[i], "-frames"))
+			config.perFrame = true;
+		else if (!strcmp(args[i], "-tree"))
+			config.tree = true;
+		else if (!strcmp(args[i], "-tunnel"))
+			config.tunnel = true;
+		else if (!strcmp(args[i], "-stack"))
+			config.stack = true;
+		else if (!strcmp(args[i], "-height") && hasValue)
+			config.stackHeight = static_cast<unsigned>(atoi(args[++i]));
+		else if (!strcmp(args[i], "-json") && hasValue)
+			config.json = args[++i];
+		else if (!strcmp(args[i], "-sat"))
+			config.sat = true;
+		else if (!strcmp(args[i], "-nowarm"))
+			config.warmStarting = false;
+		else if (!strcmp(args[i], "-speed") && hasValue)
+			config.bulletSpeed = static_cast<float>(atof(args[++i]));
+	}
+
+	PhysicsBenchmark::start_jobs(config);
+
+	if (config.tunnel)
+		PhysicsBenchmark::run_tunnelling(config);
+	else if (config.stack)
+		PhysicsBenchmark::run_stacking(config);
+	else if (config.sat)
+		PhysicsBenchmark::run_sat_kernels(config);
+	else
+		PhysicsBenchmark::run(config);
+
+	PhysicsBenchmark::stop_jobs();
+
+	return 0;
+}
@@ -0,0 +1,717 @@
+#include "physics_benchmark.h"
+#include "object.hpp"
+#include "object_manager.hpp"
+#include "component_manager.hpp"
+#include "physics_system.hpp"
+#include "transform.hpp"
+#include "collider_2d.hpp"
+#include "rigidbody.hpp"
+#include "sat_kernels.hpp"
+#include "job_system.hpp"
+#include "stringbuffer.h"
+#include "prettywriter.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <string>
+
+jeBegin
+
+ObjectMap PhysicsBenchmark::objects_;
+std::vector<ObjectHandle> PhysicsBenchmark::handles_;
+std::atomic<unsigned long long> PhysicsBenchmark::allocations(0);
+
+const unsigned BULLET = 0x0002;
+
+const float WALL_HALF_WIDTH = 0.05f;
+const float BULLET_HALF_SIZE = 0.1f;
+const float BULLET_SPACING = 0.5f;
+
+const float GRAVITY = -9.8f;
+const float BOX_HALF_SIZE = 0.5f;
+
+void PhysicsBenchmark::run(const Config& config)
+{
+	register_builders();
+	build_scene(config);
+
+	PhysicsSystem::broadPhase = config.tree
+		? PhysicsSystem::BroadPhase::AABB_TREE : PhysicsSystem::BroadPhase::SWEEP_AND_PRUNE;
+	PhysicsSystem::threadCount = config.threads;
+
+	// one fixed step per update
+	PhysicsSystem::fixedStep = config.dt;
+
+	unsigned long long totalCandidates = 0, totalContacts = 0, totalAllocations = 0;
+	double totalMs = 0.0, worstMs = 0.0;
+
+	for (unsigned step = 0; step < config.steps; ++step)
+	{
+		unsigned long long allocated = allocations;
+		auto begin = std::chrono::high_resolution_clock::now();
+		PhysicsSystem::update(config.dt);
+		auto end = std::chrono::high_resolution_clock::now();
+		allocated = allocations - allocated;
+
+		double ms = std::chrono::duration<double, std::milli>(end - begin).count();
+		const PhysicsSystem::Stats& stats = PhysicsSystem::get_stats();
+
+		totalMs += ms;
+		if (ms > worstMs) worstMs = ms;
+		totalCandidates += stats.candidates;
+		totalContacts += stats.contacts;
+		totalAllocations += allocated;
+
+		if (config.perFrame)
+			printf("frame %4u: %.3f ms, pairs tested %u, pairs found %u, allocations %llu, awake %u, asleep %u\n",
+				step, ms, stats.candidates, stats.contacts, allocated, stats.awake, stats.asleep);
+	}
+
+	unsigned long long n = config.bodies;
+	unsigned long long allPairs = n * (n - 1) / 2;
+	double steps = config.steps ? static_cast<double>(config.steps) : 1.0;
+	const PhysicsSystem::Stats& stats = PhysicsSystem::get_stats();
+
+	Report report;
+	report.msAvg = totalMs / steps;
+	report.msWorst = worstMs;
+	report.candidates = totalCandidates / steps;
+	report.contacts = totalContacts / steps;
+	report.allocations = totalAllocations / steps;
+	report.awake = stats.awake;
+	report.asleep = stats.asleep;
+
+	// same seed must give the same result for any thread count
+	report.checksum = checksum();
+
+	printf("bodies %u, steps %u, seed %u, static %.2f, circles %.2f, bullets %.2f, broad phase %s\n", config.bodies,
+		config.steps, config.seed, config.staticRatio, config.circleRatio, config.bulletRatio,
+		config.tree ? "aabb tree" : "sweep and prune");
+	printf("ms/step avg %.3f, worst %.3f\n", report.msAvg, report.msWorst);
+	printf("pairs tested/step %.1f (brute force %llu), pairs found/step %.1f\n",
+		report.candidates, allPairs, report.contacts);
+	printf("allocations/step %.1f\n", report.allocations);
+	printf("bodies awake %u, asleep %u at the last step\n", report.awake, report.asleep);
+	printf("state checksum %08x\n", report.checksum);
+
+	for (const auto& pool : objects_.arena.get_pools())
+	{
+		if (pool)
+			printf("pool %s: %u/%u blocks of %zu bytes in use, high water %u\n", pool->get_name(),
+				pool->get_used(), pool->get_capacity(), pool->get_block_size(), pool->get_high_water());
+	}
+
+	if (config.json)
+		write_json(config, report);
+
+	clear_scene();
+}
+
+void PhysicsBenchmark::run_tunnelling(const Config& config)
+{
+	register_builders();
+
+	PhysicsSystem::broadPhase = config.tree
+		? PhysicsSystem::BroadPhase::AABB_TREE : PhysicsSystem::BroadPhase::SWEEP_AND_PRUNE;
+	PhysicsSystem::threadCount = config.threads;
+	PhysicsSystem::fixedStep = config.dt;
+
+	printf("bullets %u, speed %.2f/step, wall width %.2f, steps %u, seed %u\n", config.bodies,
+		config.bulletSpeed, WALL_HALF_WIDTH * 2.f, config.steps, config.seed);
+
+	// same shots without and with the swept bounds
+	for (int ccd = 0; ccd < 2; ++ccd)
+	{
+		build_wall_scene(config, ccd != 0);
+
+		double totalMs = 0.0;
+		for (unsigned step = 0; step < config.steps; ++step)
+		{
+			auto begin = std::chrono::high_resolution_clock::now();
+			PhysicsSystem::update(config.dt);
+			auto end = std::chrono::high_resolution_clock::now();
+			totalMs += std::chrono::duration<double, std::milli>(end - begin).count();
+		}
+
+		// a bullet behind the wall went through it
+		unsigned misses = 0;
+		for (unsigned i = 0; i < config.bodies; ++i)
+		{
+			Object* bullet = ObjectManager::get_object(handles_[i]);
+			if (bullet && bullet->get_component<Transform>()->position.x > WALL_HALF_WIDTH)
+				++misses;
+		}
+
+		double steps = config.steps ? static_cast<double>(config.steps) : 1.0;
+		printf("%s: tunnelling misses %u/%u, ms/step avg %.3f\n", ccd ? "swept bounds" : "discrete",
+			misses, config.bodies, totalMs / steps);
+
+		clear_scene();
+	}
+}
+
+void PhysicsBenchmark::run_stacking(const Config& config)
+{
+	register_builders();
+	build_stack_scene(config);
+
+	PhysicsSystem::broadPhase = config.tree
+		? PhysicsSystem::BroadPhase::AABB_TREE : PhysicsSystem::BroadPhase::SWEEP_AND_PRUNE;
+	PhysicsSystem::threadCount = config.threads;
+	PhysicsSystem::warmStarting = config.warmStarting;
+	PhysicsSystem::fixedStep = config.dt;
+
+	double totalMs = 0.0;
+	unsigned settled = 0;
+	unsigned long long warmStarted = 0;
+
+	for (unsigned step = 0; step < config.steps; ++step)
+	{
+		// sleeping bodies are not woken up by the gravity
+		for (unsigned i = 0; i < config.bodies; ++i)
+		{
+			Object* box = ObjectManager::get_object(handles_[i]);
+			if (box)
+				box->get_component<RigidBody>()->add_impulse(vec3(0.f, GRAVITY, 0.f), config.dt, false);
+		}
+
+		auto begin = std::chrono::high_resolution_clock::now();
+		PhysicsSystem::update(config.dt);
+		auto end = std::chrono::high_resolution_clock::now();
+		totalMs += std::chrono::duration<double, std::milli>(end - begin).count();
+
+		const PhysicsSystem::Stats& stats = PhysicsSystem::get_stats();
+		warmStarted += stats.warmStarted;
+		if (!settled && !stats.awake)
+			settled = step + 1;
+
+		if (config.perFrame)
+			printf("frame %4u: contacts %u, colors %u, manifolds %u, warm started %u, awake %u\n",
+				step, stats.contacts, stats.colors, stats.manifolds, stats.warmStarted, stats.awake);
+	}
+
+	// how far the boxes sank into each other or drifted off their column
+	float drift = 0.f;
+	for (unsigned i = 0; i < config.bodies; ++i)
+	{
+		Object* box = ObjectManager::get_object(handles_[i]);
+		if (!box)
+			continue;
+
+		unsigned column = i / config.stackHeight, row = i % config.stackHeight;
+		vec3 start(column * BOX_HALF_SIZE * 4.f, BOX_HALF_SIZE * (2.f * row + 1.f), 0.f);
+		float d = (box->get_component<Transform>()->position - start).length();
+		if (d > drift) drift = d;
+	}
+
+	double steps = config.steps ? static_cast<double>(config.steps) : 1.0;
+	const PhysicsSystem::Stats& stats = PhysicsSystem::get_stats();
+
+	printf("boxes %u, stack height %u, steps %u, iterations %d, warm starting %s\n", config.bodies,
+		config.stackHeight, config.steps, PhysicsSystem::iterations, config.warmStarting ? "on" : "off");
+	printf("ms/step avg %.3f, warm started/step %.1f\n", totalMs / steps, warmStarted / steps);
+	printf("all asleep at step %u, awake at the last step %u, max drift %.4f\n",
+		settled, stats.awake, drift);
+
+	clear_scene();
+}
+
+static void get_interval(const vec3* vertices, int size, const vec3& xAxis, float& min, float& max)
+{
+	min = max = vertices[0].dot(xAxis);
+
+	for (int i = 1; i < size; i++)
+	{
+		float d = vertices[i].dot(xAxis);
+
+		if (d < min)
+			min = d;
+		else if (d > max)
+			max = d;
+	}
+}
+
+static bool interval_intersect(const vec3* A, int aSize, const vec3* B, int bSize,
+	const vec3& xAxis, const vec3& xOffset, const vec3& xVel,
+	const mat3& xOrient, float& tAxis, const float tMax)
+{
+	float min0, max0;
+	float min1, max1;
+	get_interval(A, aSize, xOrient.transposed() * xAxis, min0, max0);
+	get_interval(B, bSize, xAxis, min1, max1);
+
+	float h = xOffset.dot(xAxis);
+	min0 += h;
+	max0 += h;
+
+	float d0 = min0 - max1;
+	float d1 = min1 - max0;
+
+	if (d0 > 0.0f || d1 > 0.0f)
+	{
+		float v = xVel.dot(xAxis);
+		if (fabs(v) < 0.0000001f)
+			return false;
+
+		float t0 = -d0 / v;
+		float t1 = d1 / v;
+
+		if (t0 > t1) { float temp = t0; t0 = t1; t1 = temp; }
+		tAxis = (t0 > 0.0f) ? t0 : t1;
+
+		return tAxis >= 0.0f && tAxis <= tMax;
+	}
+
+	tAxis = (d0 > d1) ? d0 : d1;
+	return true;
+}
+
+static bool find_MTD(vec3* xAxis, float* taxis, int iAxes, vec3& N, float& t)
+{
+	int mini = -1;
+
+	t = 0.0f;
+	for (int i = 0; i < iAxes; i++)
+	{
+		if (taxis[i] > 0 && taxis[i] > t)
+		{
+			mini = i;
+			t = taxis[i];
+			N = xAxis[i];
+			N.normalize();
+		}
+	}
+
+	if (mini != -1)
+		return true;
+
+	for (int i = 0; i < iAxes; i++)
+	{
+		float n = xAxis[i].length();
+		taxis[i] /= n;
+
+		if (taxis[i] > t || mini == -1)
+		{
+			mini = i;
+			t = taxis[i];
+			N = xAxis[i] / n;
+		}
+	}
+
+	return mini != -1;
+}
+
+bool PhysicsBenchmark::collide_per_vertex(Collider2D* a, Collider2D* b, const vec3& displacement, vec3& N, float& t)
+{
+	const vec3* aVertices = a->get_vertices();
+	const vec3* bVertices = b->get_vertices();
+
+	int aSize = a->get_vertex_count();
+	int bSize = b->get_vertex_count();
+
+	if (!aSize || !bSize) return false;
+
+	mat3 bTransposed = b->get_rotation().transposed();
+	vec3 relPos = bTransposed * (a->get_position() - b->get_position());
+	vec3 relDis = bTransposed * displacement;
+	mat3 relOrient = bTransposed * a->get_rotation();
+
+	const int MAX_AXES = 32;
+	vec3 xAxis[MAX_AXES];
+	float tAxis[MAX_AXES];
+	int iAxes = 0;
+
+	auto test = [&](const vec3& axis) {
+		xAxis[iAxes] = axis;
+		if (!interval_intersect(aVertices, aSize, bVertices, bSize, xAxis[iAxes], relPos, relDis, relOrient, tAxis[iAxes], t))
+			return false;
+
+		iAxes++;
+		return true;
+	};
+
+	if (relDis.dot(relDis) > 0.000001f && !test(vec3(-relDis.y, relDis.x, 0.f)))
+		return false;
+
+	for (int j = aSize - 1, i = 0; i < aSize; j = i, i++)
+	{
+		vec3 E = aVertices[i] - aVertices[j];
+		if (!test(relOrient * vec3(-E.y, E.x, 0.f)))
+			return false;
+	}
+
+	for (int j = bSize - 1, i = 0; i < bSize; j = i, i++)
+	{
+		vec3 E = bVertices[i] - bVertices[j];
+		if (!test(vec3(-E.y, E.x, 0.f)))
+			return false;
+	}
+
+	if (bSize == 2 && !test(bVertices[1] - bVertices[0]))
+		return false;
+
+	if (aSize == 2 && !test(relOrient * (aVertices[1] - aVertices[0])))
+		return false;
+
+	if (!find_MTD(xAxis, tAxis, iAxes, N, t))
+		return false;
+
+	if (N.dot(relPos) < 0.0f)
+		N = -N;
+
+	N = b->get_rotation() * N;
+	return true;
+}
+
+void PhysicsBenchmark::run_sat_kernels(const Config& config)
+{
+	register_builders();
+
+	// boxes only, packed and turned so that most candidates need every axis
+	Config boxes = config;
+	boxes.circleRatio = 0.f;
+	boxes.worldSize = sqrtf(static_cast<float>(config.bodies)) * 1.5f;
+	build_scene(boxes);
+
+	std::mt19937 rand(config.seed);
+	std::uniform_real_distribution<float> angle(0.f, 360.f);
+	for (unsigned i = 0; i < config.bodies; ++i)
+	{
+		Object* body = ObjectManager::get_object(handles_[i]);
+		if (body)
+			body->get_component<Transform>()->set_euler_deg(0.f, 0.f, angle(rand));
+	}
+
+	// one step for the candidate pairs, then the same pairs over and over
+	PhysicsSystem::broadPhase = PhysicsSystem::BroadPhase::SWEEP_AND_PRUNE;
+	PhysicsSystem::fixedStep = config.dt;
+	PhysicsSystem::update(config.dt);
+
+	std::vector<ColliderPair> pairs;
+	for (const auto& pair : PhysicsSystem::get_candidate_pairs())
+		if (pair.a->get_body() && pair.b->get_body())
+			pairs.push_back(pair);
+
+	unsigned rounds = config.steps ? config.steps : 1;
+	printf("boxes %u, candidate pairs %u, rounds %u, seed %u\n", config.bodies,
+		static_cast<unsigned>(pairs.size()), rounds, config.seed);
+
+	// the per-vertex baseline first, then the kernels
+	const SATKernels::Path paths[] = { SATKernels::Path::SCALAR, SATKernels::Path::SCALAR, SATKernels::Path::SSE, SATKernels::Path::AVX };
+	const char* names[] = { "vertex", "scalar", "sse", "avx" };
+	SATKernels::Path selected = SATKernels::get_path();
+
+	double baseRate = 0.0;
+	unsigned scalarHash = 0;
+	for (int p = 0; p < 4; ++p)
+	{
+		if (!SATKernels::is_supported(paths[p]))
+		{
+			printf("%-6s: not supported\n", names[p]);
+			continue;
+		}
+
+		SATKernels::set_path(paths[p]);
+		bool perVertex = p == 0;
+
+		// fnv-1a over the results, every kernel must agree to the bit.
+		// the baseline rounds differently, only its hits are comparable
+		unsigned hash = 2166136261u, hits = 0;
+		auto begin = std::chrono::high_resolution_clock::now();
+		for (unsigned round = 0; round < rounds; ++round)
+		{
+			for (const auto& pair : pairs)
+			{
+				// the same relative displacement on both sides
+				RigidBody* aBody = pair.a->get_body();
+				RigidBody* bBody = pair.b->get_body();
+
+				vec3 N;
+				float t = 1.f;
+				bool hit = perVertex
+					? collide_per_vertex(pair.a, pair.b, aBody->get_displacement() - bBody->get_displacement(), N, t)
+					: PhysicsSystem::is_collided(pair.a, pair.b, aBody, bBody, N, t);
+				if (!hit)
+					continue;
+
+				++hits;
+				if (round)
+					continue;
+
+				unsigned bits[3];
+				memcpy(bits, &N.x, sizeof(float));
+				memcpy(bits + 1, &N.y, sizeof(float));
+				memcpy(bits + 2, &t, sizeof(float));
+				for (unsigned b : bits)
+				{
+					hash ^= b;
+					hash *= 16777619u;
+				}
+			}
+		}
+		auto end = std::chrono::high_resolution_clock::now();
+
+		double seconds = std::chrono::duration<double>(end - begin).count();
+		double rate = seconds > 0.0 ? pairs.size() * static_cast<double>(rounds) / seconds : 0.0;
+		if (perVertex)
+			baseRate = rate;
+		else if (paths[p] == SATKernels::Path::SCALAR)
+			scalarHash = hash;
+
+		printf("%-6s: %.0f pairs/s, x%.2f of per-vertex, hits/round %u, result hash %08x%s\n", names[p], rate,
+			baseRate > 0.0 ? rate / baseRate : 0.0, hits / rounds, hash,
+			perVertex || hash == scalarHash ? "" : " MISMATCH");
+	}
+
+	SATKernels::set_path(selected);
+	clear_scene();
+}
+
+void PhysicsBenchmark::start_jobs(const Config& config)
+{
+	JobSystem::initialize(config.threads);
+}
+
+void PhysicsBenchmark::stop_jobs()
+{
+	JobSystem::close();
+}
+
+void PhysicsBenchmark::register_builders()
+{
+	static bool registered = false;
+	if (registered)
+		return;
+
+	ComponentManager::register_component<Transform, TransformBuilder>("Transform");
+	ComponentManager::register_component<Collider2D, Collider2DBuilder>("Collider2D");
+	ComponentManager::register_component<RigidBody, RigidBodyBuilder>("RigidBody");
+
+	registered = true;
+}
+
+void PhysicsBenchmark::build_scene(const Config& config)
+{
+	ObjectManager::set_objects(&objects_);
+	PhysicsSystem::initialize();
+
+	std::mt19937 rand(config.seed);
+	std::uniform_real_distribution<float> position(-config.worldSize, config.worldSize);
+	std::uniform_real_distribution<float> direction(-1.f, 1.f);
+	std::uniform_real_distribution<float> ratio(0.f, 1.f);
+
+	for (unsigned i = 0; i < config.bodies; ++i)
+	{
+		Object* obj = ObjectManager::create_object();
+		obj->add_component<Collider2D>();
+		obj->add_component<RigidBody>();
+
+		if (config.circleRatio > 0.f && ratio(rand) < config.circleRatio)
+			obj->get_component<Collider2D>()->coliisionType_ = Collider2D::ColliderType::CIRCLE;
+
+		Transform* transform = obj->get_component<Transform>();
+		transform->position.set(position(rand), position(rand), 0.f);
+
+		RigidBody* body = obj->get_component<RigidBody>();
+		body->isStatic = ratio(rand) < config.staticRatio;
+
+		// the displacement is kept between the steps, so one push keeps it moving
+		if (!body->isStatic)
+			body->add_impulse(vec3(direction(rand), direction(rand), 0.f) * config.speed, 1.f);
+
+		// bullets do not hit each other
+		if (!body->isStatic && config.bulletRatio > 0.f && ratio(rand) < config.bulletRatio)
+		{
+			Collider2D* collider = obj->get_component<Collider2D>();
+			collider->category = BULLET;
+			collider->mask &= ~BULLET;
+		}
+
+		handles_.emplace_back(obj->get_handle());
+		obj->register_components();
+	}
+}
+
+void PhysicsBenchmark::build_wall_scene(const Config& config, bool ccd)
+{
+	ObjectManager::set_objects(&objects_);
+	PhysicsSystem::initialize();
+
+	std::mt19937 rand(config.seed);
+	std::uniform_real_distribution<float> offset(0.f, config.bulletSpeed);
+
+	float height = config.bodies * BULLET_SPACING;
+
+	Object* wall = ObjectManager::create_object("wall");
+	wall->add_component<Collider2D>();
+	wall->add_component<RigidBody>();
+	wall->get_component<Transform>()->position.set(0.f, height * 0.5f, 0.f);
+	wall->get_component<Transform>()->scale.set(WALL_HALF_WIDTH, height * 0.5f + 1.f, 1.f);
+	wall->get_component<RigidBody>()->isStatic = true;
+	wall->register_components();
+
+	for (unsigned i = 0; i < config.bodies; ++i)
+	{
+		Object* obj = ObjectManager::create_object();
+		obj->add_component<Collider2D>();
+		obj->add_component<RigidBody>();
+
+		// every other bullet is a circle
+		Collider2D* collider = obj->get_component<Collider2D>();
+		if (i % 2)
+			collider->coliisionType_ = Collider2D::ColliderType::CIRCLE;
+		collider->category = BULLET;
+		collider->mask &= ~BULLET;
+
+		// random phase, so the bullets meet the wall at different points of a step
+		Transform* transform = obj->get_component<Transform>();
+		transform->position.set(-10.f - offset(rand), i * BULLET_SPACING, 0.f);
+		transform->scale.set(BULLET_HALF_SIZE, BULLET_HALF_SIZE, 1.f);
+
+		RigidBody* body = obj->get_component<RigidBody>();
+		body->isBullet = ccd;
+		body->add_impulse(vec3(config.bulletSpeed, 0.f, 0.f), 1.f);
+
+		handles_.emplace_back(obj->get_handle());
+		obj->register_components();
+	}
+}
+
+void PhysicsBenchmark::build_stack_scene(const Config& config)
+{
+	ObjectManager::set_objects(&objects_);
+	PhysicsSystem::initialize();
+
+	unsigned height = config.stackHeight ? config.stackHeight : 1;
+	unsigned columns = (config.bodies + height - 1) / height;
+	float width = columns * BOX_HALF_SIZE * 4.f;
+
+	Object* ground = ObjectManager::create_object("ground");
+	ground->add_component<Collider2D>();
+	ground->add_component<RigidBody>();
+	ground->get_component<Transform>()->position.set(width * 0.5f, -1.f, 0.f);
+	ground->get_component<Transform>()->scale.set(width * 0.5f + 1.f, 1.f, 1.f);
+	ground->get_component<RigidBody>()->isStatic = true;
+	ground->register_components();
+
+	// columns of boxes resting on each other
+	for (unsigned i = 0; i < config.bodies; ++i)
+	{
+		Object* obj = ObjectManager::create_object();
+		obj->add_component<Collider2D>();
+		obj->add_component<RigidBody>();
+
+		unsigned column = i / height, row = i % height;
+		Transform* transform = obj->get_component<Transform>();
+		transform->position.set(column * BOX_HALF_SIZE * 4.f, BOX_HALF_SIZE * (2.f * row + 1.f), 0.f);
+		transform->scale.set(BOX_HALF_SIZE, BOX_HALF_SIZE, 1.f);
+
+		handles_.emplace_back(obj->get_handle());
+		obj->register_components();
+	}
+}
+
+void PhysicsBenchmark::write_json(const Config& config, const Report& report)
+{
+	rapidjson::StringBuffer buffer;
+	rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+
+	writer.StartObject();
+
+	writer.Key("config");
+	writer.StartObject();
+	writer.Key("bodies"); writer.Uint(config.bodies);
+	writer.Key("steps"); writer.Uint(config.steps);
+	writer.Key("seed"); writer.Uint(config.seed);
+	writer.Key("threads"); writer.Uint(config.threads);
+	writer.Key("staticRatio"); writer.Double(config.staticRatio);
+	writer.Key("circleRatio"); writer.Double(config.circleRatio);
+	writer.Key("bulletRatio"); writer.Double(config.bulletRatio);
+	writer.Key("worldSize"); writer.Double(config.worldSize);
+	writer.Key("dt"); writer.Double(config.dt);
+	writer.Key("broadPhase"); writer.String(config.tree ? "aabb_tree" : "sweep_and_prune");
+	writer.EndObject();
+
+	writer.Key("result");
+	writer.StartObject();
+	writer.Key("msPerStep"); writer.Double(report.msAvg);
+	writer.Key("msWorst"); writer.Double(report.msWorst);
+	writer.Key("candidatesPerStep"); writer.Double(report.candidates);
+	writer.Key("contactsPerStep"); writer.Double(report.contacts);
+	writer.Key("allocationsPerStep"); writer.Double(report.allocations);
+	writer.Key("awake"); writer.Uint(report.awake);
+	writer.Key("asleep"); writer.Uint(report.asleep);
+
+	char hash[16];
+	snprintf(hash, sizeof(hash), "%08x", report.checksum);
+	writer.Key("checksum"); writer.String(hash);
+	writer.EndObject();
+
+	writer.Key("pools");
+	writer.StartArray();
+	for (const auto& pool : objects_.arena.get_pools())
+	{
+		if (!pool)
+			continue;
+
+		writer.StartObject();
+		writer.Key("type"); writer.String(pool->get_name());
+		writer.Key("blockSize"); writer.Uint(static_cast<unsigned>(pool->get_block_size()));
+		writer.Key("used"); writer.Uint(pool->get_used());
+		writer.Key("capacity"); writer.Uint(pool->get_capacity());
+		writer.Key("highWater"); writer.Uint(pool->get_high_water());
+		writer.EndObject();
+	}
+	writer.EndArray();
+
+	writer.EndObject();
+
+	std::ofstream file(config.json);
+	if (!file)
+	{
+		printf("cannot open %s\n", config.json);
+		return;
+	}
+
+	file << buffer.GetString() << '\n';
+}
+
+void PhysicsBenchmark::clear_scene()
+{
+	PhysicsSystem::close();
+	ObjectManager::clear_objects();
+	ObjectManager::set_objects(nullptr);
+	handles_.clear();
+}
+
+unsigned PhysicsBenchmark::checksum()
+{
+	// fnv-1a over the raw bits of the final positions
+	unsigned hash = 2166136261u;
+
+	for (const auto& handle : handles_)
+	{
+		Object* body = ObjectManager::get_object(handle);
+		if (!body)
+			continue;
+
+		const vec3& position = body->get_component<Transform>()->position;
+		unsigned char bytes[sizeof(float) * 2];
+		memcpy(bytes, &position.x, sizeof(float));
+		memcpy(bytes + sizeof(float), &position.y, sizeof(float));
+
+		for (unsigned char byte : bytes)
+		{
+			hash ^= byte;
+			hash *= 16777619u;
+		}
+	}
+
+	return hash;
+}
+
+jeEnd
\ No newline at end of file
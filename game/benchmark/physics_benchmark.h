@@ -0,0 +1,84 @@
+#pragma once
+#include "assets.hpp"
+#include <atomic>
+
+struct vec3;
+
+jeBegin
+
+class Collider2D;
+
+// headless physics stress test
+// builds a field of boxes and runs PhysicsSystem without SDL, GL or FMOD
+class PhysicsBenchmark {
+
+	// Prevent to clone this class
+	PhysicsBenchmark() = delete;
+	~PhysicsBenchmark() = delete;
+
+	jePreventClone(PhysicsBenchmark)
+
+public:
+
+	struct Config {
+		unsigned bodies = 2000;
+		unsigned steps = 300;
+		unsigned seed = 1;
+		unsigned threads = 0;
+		float staticRatio = 0.5f;
+		float bulletRatio = 0.f; // dynamic bodies ignoring each other
+		float circleRatio = 0.f;
+		float worldSize = 150.f;
+		float speed = 0.5f;
+		float dt = 1.f / 60.f;
+		bool perFrame = false;
+		bool tree = false;
+		bool tunnel = false; // fire the bodies at a thin wall
+		bool stack = false; // pile the bodies up under gravity
+		bool sat = false; // time the polygon tests with each projection kernel
+		unsigned stackHeight = 10;
+		bool warmStarting = true;
+		float bulletSpeed = 4.f; // distance per step
+		const char* json = nullptr; // report file
+	};
+
+	// counted by the global operator new of the executable
+	static std::atomic<unsigned long long> allocations;
+
+	static void run(const Config& config);
+	static void run_tunnelling(const Config& config);
+	static void run_stacking(const Config& config);
+	static void run_sat_kernels(const Config& config);
+
+	// one thread per narrow phase worker, the hardware concurrency for 0
+	static void start_jobs(const Config& config);
+	static void stop_jobs();
+
+private:
+
+	static void register_builders();
+	static void build_scene(const Config& config);
+	static void build_wall_scene(const Config& config, bool ccd);
+	static void build_stack_scene(const Config& config);
+	static void clear_scene();
+	static unsigned checksum();
+
+	// the polygon test before the projection kernels, one axis at a time
+	// with an early out, the baseline of run_sat_kernels
+	static bool collide_per_vertex(Collider2D* a, Collider2D* b, const vec3& displacement, vec3& N, float& t);
+
+	struct Report {
+		double msAvg = 0.0, msWorst = 0.0;
+		double candidates = 0.0, contacts = 0.0; // per step
+		double allocations = 0.0; // per step
+		unsigned awake = 0, asleep = 0;
+		unsigned checksum = 0;
+	};
+
+	static void write_json(const Config& config, const Report& report);
+
+	static ObjectMap objects_;
+	static std::vector<ObjectHandle> handles_; // bodies in the order of the creation
+};
+
+jeEnd
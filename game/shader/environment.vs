@@ -6,9 +6,7 @@ layout (location = 1) in vec3 normal;
 ////////////////////////////
 // uniform variables
 ////////////////////////////
-uniform mat4 m4_translate;
-uniform mat4 m4_scale;
-uniform mat4 m4_rotate;
+uniform mat4 m4_model;
 uniform mat4 m4_viewport;
 uniform mat4 m4_projection;
 
@@ -23,7 +21,7 @@ out	vec3 v3_outFragmentPosition;
 ////////////////////////////
 void main()
 {
-	mat4 model = m4_scale *m4_rotate * m4_translate;
+	mat4 model = m4_model;
 	v3_outNormal = normal;//mat3(transpose(inverse(transpose(model)))) * normal;
 	vec4 v4_position = vec4(position, 1);
 	v3_outFragmentPosition = vec3(transpose(model) * v4_position);;//position;//vec3(transpose(model)*vec4(position, 1.0));
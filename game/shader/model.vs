@@ -4,9 +4,7 @@ layout(location = 0) in vec3 position;
 layout(location = 1) in vec3 normal;
 layout(location = 2) in vec2 uvPosition;
 
-uniform mat4 m4_translate;
-uniform mat4 m4_scale;
-uniform mat4 m4_rotate;
+uniform mat4 m4_model;
 uniform mat4 m4_viewport;
 uniform mat4 m4_projection;
 
@@ -19,7 +17,7 @@ out	vec3 v3_outFragmentPosition;
 
 void main()
 {
-	mat4 model = m4_scale * m4_rotate * m4_translate;
+	mat4 model = m4_model;
 	mat4 mvp = transpose(m4_projection) * transpose(m4_viewport)* transpose(model);
 	vec4 v4_position = vec4(position, 1);
 	
@@ -16,10 +16,6 @@ uniform mat4 m4_projection;
 uniform bool boolean_hide;
 uniform bool boolean_bilboard;
 
-uniform bool hasParent;
-uniform mat4 m4_parentTranslate,
-	m4_parentScale, m4_parentRotate;
-
 ////////////////////////////
 // out variables
 ////////////////////////////
@@ -59,8 +55,6 @@ void main(){
 void Transforming(vec4 _position, mat4 _model) {
 	
 	mat4 newModel = transpose(_model);
-	if (hasParent) 
-		newModel = transpose(m4_parentScale * m4_parentRotate * m4_parentTranslate) * newModel;
 
 	// Calculate mvp transform matrix
 	mat4 modelview = transpose(m4_viewport) * newModel;
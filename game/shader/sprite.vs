@@ -12,9 +12,7 @@ const int MAX_ARRAY = 16;
 ////////////////////////////
 // uniform variables
 ////////////////////////////
-uniform mat4 m4_translate;
-uniform mat4 m4_scale;
-uniform mat4 m4_rotate;
+uniform mat4 m4_model;
 uniform mat4 m4_viewport;
 uniform mat4 m4_projection;
 
@@ -27,10 +25,6 @@ uniform bool boolean_flip;
 uniform bool boolean_light;
 uniform bool boolean_bilboard;
 
-uniform bool boolean_herited;
-uniform mat4 m4_parentTranslate,
-	m4_parentScale, m4_parentRotate;
-
 ////////////////////////////
 // out variables
 ////////////////////////////
@@ -51,7 +45,7 @@ void SendToFrag(vec4 _position, vec4 _texCoord, mat4 _model);
 void main() {
 
 	vec4 newPosition = vec4(position, 1);
-	mat4 model = m4_scale * m4_rotate * m4_translate;
+	mat4 model = m4_model;
 	vec4 newTexCoord;
 
 	Transforming(newPosition, model);
@@ -66,8 +60,6 @@ void main() {
 void Transforming(vec4 _position, mat4 _model) {
 	
 	mat4 newModel = transpose(_model);
-	if (boolean_herited) 
-		newModel = transpose(m4_parentScale * m4_parentRotate * m4_parentTranslate) * newModel;
 
 	// Calculate mvp transform matrix
 	mat4 modelview;
@@ -8,6 +8,7 @@
 #include "scene.hpp"
 #include "object.hpp"
 #include "object_manager.hpp"
+#include "command_buffer.hpp"
 #include "asset_manager.hpp"
 #include "component_builder.hpp"
 
@@ -0,0 +1,110 @@
+/******************************************************************************/
+/*!
+\file   aabb_tree.hpp
+\author Jeong Juyong
+\par    email: jaykop.jy\@gmail.com
+\date   2026/10/17(yy/mm/dd)
+
+\description
+Contains the definition of AABBTree class
+*/
+/******************************************************************************/
+
+#pragma once
+#include <broad_phase.hpp>
+
+jeBegin
+
+// dynamic bounding volume hierarchy
+// leaves keep fattened boxes, so a proxy is reinserted
+// only when its collider leaves the fat box
+class AABBTree {
+
+	jePreventClone(AABBTree)
+
+public:
+
+	static const int NULL_NODE = -1;
+	static const int STACK_SIZE = 256;
+
+	AABBTree() {};
+	~AABBTree() {};
+
+	int create_proxy(const AABB& aabb, Collider2D* collider);
+	void destroy_proxy(int proxyId);
+	bool move_proxy(int proxyId, const AABB& aabb, const vec3& displacement);
+	void clear();
+
+	Collider2D* get_collider(int proxyId) const { return nodes_[proxyId].collider; }
+	const AABB& get_fat_aabb(int proxyId) const { return nodes_[proxyId].aabb; }
+	unsigned get_proxy_count() const { return proxyCount_; }
+	int get_height() const;
+
+	// callback(int proxyId) -> bool, return false to stop the query
+	template <class Callback>
+	void query(const AABB& aabb, Callback callback) const;
+
+	// callback(int proxyId, float maxFraction) -> float,
+	// return 0 to stop, the fraction to clip the ray or maxFraction to go on
+	template <class Callback>
+	void raycast(const vec3& from, const vec3& to, Callback callback) const;
+
+	float margin = 1.f;
+	float displacementMultiplier = 2.f;
+
+private:
+
+	struct Node {
+
+		AABB aabb;
+		Collider2D* collider = nullptr;
+		int parent = NULL_NODE;
+		int next = NULL_NODE; // free list link
+		int child1 = NULL_NODE, child2 = NULL_NODE;
+		int height = -1; // leaf is 0, free node is -1
+
+		bool is_leaf() const { return child1 == NULL_NODE; }
+	};
+
+	// nodes to visit, a balanced tree fits in the array and
+	// a degenerate one spills the rest onto the heap
+	class Stack {
+	public:
+		bool empty() const { return !count_ && overflow_.empty(); }
+
+		void push(int id)
+		{
+			if (count_ < STACK_SIZE && overflow_.empty()) fixed_[count_++] = id;
+			else overflow_.push_back(id);
+		}
+
+		int pop()
+		{
+			if (overflow_.empty()) return fixed_[--count_];
+			int id = overflow_.back();
+			overflow_.pop_back();
+			return id;
+		}
+
+	private:
+		int fixed_[STACK_SIZE];
+		int count_ = 0;
+		std::vector<int> overflow_;
+	};
+
+	int allocate_node();
+	void free_node(int node);
+
+	void insert_leaf(int leaf);
+	void remove_leaf(int leaf);
+	int balance(int node);
+
+	int root_ = NULL_NODE;
+	int freeList_ = NULL_NODE;
+	unsigned proxyCount_ = 0;
+	std::vector<Node> nodes_;
+};
+
+jeEnd
+
+#include <aabb_tree.inl>
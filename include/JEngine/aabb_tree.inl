@@ -0,0 +1,121 @@
+/******************************************************************************/
+/*!
+\file   aabb_tree.inl
+\author Jeong Juyong
+\par    email: jaykop.jy\@gmail.com
+\date   2026/10/17(yy/mm/dd)
+
+\description
+Contains the template methods of AABBTree class
+*/
+/******************************************************************************/
+
+#pragma once
+#include <cmath>
+#include <aabb_tree.hpp>
+
+jeBegin
+
+template <class Callback>
+void AABBTree::query(const AABB& aabb, Callback callback) const
+{
+	Stack stack;
+	if (root_ != NULL_NODE)
+		stack.push(root_);
+
+	while (!stack.empty())
+	{
+		int id = stack.pop();
+		const Node& node = nodes_[id];
+
+		if (!node.aabb.overlaps(aabb))
+			continue;
+
+		if (node.is_leaf())
+		{
+			if (!callback(id))
+				return;
+		}
+		else
+		{
+			stack.push(node.child1);
+			stack.push(node.child2);
+		}
+	}
+}
+
+template <class Callback>
+void AABBTree::raycast(const vec3& from, const vec3& to, Callback callback) const
+{
+	vec3 d = to - from;
+	float maxFraction = 1.f;
+
+	// segment bounds, shrinks as the callback clips the ray
+	AABB segment;
+	vec3 end = from + d * maxFraction;
+	segment.min.set(fminf(from.x, end.x), fminf(from.y, end.y), 0.f);
+	segment.max.set(fmaxf(from.x, end.x), fmaxf(from.y, end.y), 0.f);
+
+	Stack stack;
+	if (root_ != NULL_NODE)
+		stack.push(root_);
+
+	while (!stack.empty())
+	{
+		int id = stack.pop();
+		const Node& node = nodes_[id];
+
+		if (!node.aabb.overlaps(segment))
+			continue;
+
+		// slab test against the node box
+		float tMin = 0.f, tMax = maxFraction;
+		bool hit = true;
+		for (int axis = 0; axis < 2 && hit; ++axis)
+		{
+			float o = from.data[axis], dir = d.data[axis];
+			float lo = node.aabb.min.data[axis], hi = node.aabb.max.data[axis];
+
+			if (fabsf(dir) < 1e-8f)
+			{
+				hit = lo <= o && o <= hi;
+				continue;
+			}
+
+			float inv = 1.f / dir;
+			float t1 = (lo - o) * inv, t2 = (hi - o) * inv;
+			if (t1 > t2) { float temp = t1; t1 = t2; t2 = temp; }
+			if (t1 > tMin) tMin = t1;
+			if (t2 < tMax) tMax = t2;
+			hit = tMin <= tMax;
+		}
+
+		if (!hit)
+			continue;
+
+		if (node.is_leaf())
+		{
+			float fraction = callback(id, maxFraction);
+
+			// the client terminated the ray
+			if (fraction == 0.f)
+				return;
+
+			// clip the ray
+			if (0.f < fraction && fraction < maxFraction)
+			{
+				maxFraction = fraction;
+				end = from + d * maxFraction;
+				segment.min.set(fminf(from.x, end.x), fminf(from.y, end.y), 0.f);
+				segment.max.set(fmaxf(from.x, end.x), fmaxf(from.y, end.y), 0.f);
+			}
+		}
+		else
+		{
+			stack.push(node.child1);
+			stack.push(node.child2);
+		}
+	}
+}
+
+jeEnd
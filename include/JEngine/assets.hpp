@@ -3,6 +3,8 @@
 #include <string>
 #include <unordered_map>
 #include <macros.hpp>
+#include <memory_pool.hpp>
+#include <component_archetype.hpp>
 
 namespace FMOD
 {
@@ -23,16 +25,42 @@ struct Texture {
 
 struct Font;
 
+// index to the object slot and the generation of the slot,
+// so a handle to a removed object never finds the next one there
+struct ObjectHandle {
+
+	static const unsigned NULL_INDEX = 0xffffffff;
+
+	unsigned index = NULL_INDEX, generation = 0;
+
+	bool is_null() const { return index == NULL_INDEX; }
+	bool operator==(const ObjectHandle& other) const { return index == other.index && generation == other.generation; }
+	bool operator!=(const ObjectHandle& other) const { return !(*this == other); }
+};
+
 class Mesh;
 class Scene;
 class Object;
 class Archetype;
 
 using FontMap = std::unordered_map<std::string, Font*>;
-using ObjectMap = std::unordered_map<std::string, Object*>;
 using TextureMap = std::unordered_map<std::string, unsigned>;
 using AudioMap = std::unordered_map<std::string, FMOD::Sound*>;
 using ArchetypeMap = std::unordered_map<std::string, Archetype*>;
 using MeshMap = std::unordered_map<std::string, std::vector<Mesh*>>;
 
+// objects of a scene in the order of the creation,
+// the names are optional and kept aside for the lookup by name.
+// the objects and their components are allocated in the arena,
+// and sorted by their component sets in the archetypes
+struct ObjectMap {
+
+	using NameIndex = std::unordered_map<std::string, ObjectHandle>;
+
+	std::vector<Object*> objects;
+	NameIndex names;
+	MemoryArena arena;
+	ArchetypeStorage archetypes;
+};
+
 jeEnd
\ No newline at end of file
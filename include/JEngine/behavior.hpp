@@ -1,10 +1,15 @@
 #pragma once
 #include <component.hpp>
+#include <collision_event.hpp>
 
 jeBegin
 
 struct Telegram;
 
+// the update and the collision callbacks run on the main thread,
+// so GL, the SDL window and the asset loading are safe from a script.
+// a job started from a script runs on a worker, where only the
+// CommandBuffer and JobSystem::run_on_main are
 class Behavior : public Component {
 
 	friend class Object;
@@ -18,6 +23,11 @@ public:
 	virtual void close() = 0;
 	// virtual void unload() = 0;
 
+	// contacts of the colliders on the owner, called after the physics step
+	virtual void on_collision_begin(const CollisionEvent& /*event*/) {};
+	virtual void on_collision_stay(const CollisionEvent& /*event*/) {};
+	virtual void on_collision_end(const CollisionEvent& /*event*/) {};
+
 protected:
 
 	void add_to_system() override;
@@ -14,6 +14,7 @@ Contains the definition of BehaviorSystem class
 #include <macros.hpp>
 #include <vector>
 #include <unordered_map>
+#include <collision_event.hpp>
 
 jeBegin
 
@@ -40,12 +41,16 @@ private:
 
 	static void initialize();
 	static void update(float dt);
+	static void dispatch_collisions(const CollisionEvents& events);
 	static void close();
 
 	static void resume();
 	static void pause();
 
+	static bool is_listening(Object* owner, Behavior* behavior);
+
 	static Behaviors behaviors_;
+	static std::unordered_multimap<Object*, Behavior*> listeners_; // while dispatching
 	static std::stack<Behaviors> componentStack_;
 };
 
@@ -0,0 +1,62 @@
+/******************************************************************************/
+/*!
+\file   body_store.hpp
+\author Jeong Juyong
+\par    email: jaykop.jy\@gmail.com
+\date   2026/10/17(yy/mm/dd)
+
+\description
+Contains the definition of BodyStore class
+*/
+/******************************************************************************/
+
+#pragma once
+#include <macros.hpp>
+#include <vector>
+#include <vec3.hpp>
+
+jeBegin
+
+class RigidBody;
+class Collider2D;
+
+// simulation state of the rigid bodies in parallel arrays,
+// a body is addressed by its index which can change on removal
+class BodyStore {
+
+	jePreventClone(BodyStore)
+
+public:
+
+	static const unsigned char STATIC = 0x01;
+	static const unsigned char BULLET = 0x02;
+	static const unsigned char ASLEEP = 0x04;
+
+	BodyStore() {};
+	~BodyStore() {};
+
+	int add(RigidBody* body);
+	void remove(int index);
+	void clear();
+
+	unsigned size() const { return static_cast<unsigned>(owner.size()); }
+
+	bool is_static(int index) const { return (flags[index] & STATIC) != 0; }
+	bool is_bullet(int index) const { return (flags[index] & BULLET) != 0; }
+	bool is_asleep(int index) const { return (flags[index] & ASLEEP) != 0; }
+	bool is_active(int index) const { return !(flags[index] & (STATIC | ASLEEP)); }
+
+	std::vector<RigidBody*> owner;
+	std::vector<Collider2D*> collider;
+
+	std::vector<vec3> position, prevPosition;
+	std::vector<vec3> displacement;
+	std::vector<vec3> correction; // position correction of this step
+
+	std::vector<float> invMass;
+	std::vector<unsigned char> flags;
+	std::vector<int> restSteps;
+	std::vector<unsigned long long> colorMask; // contact colors touching the body
+};
+
+jeEnd
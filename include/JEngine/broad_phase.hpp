@@ -0,0 +1,91 @@
+/******************************************************************************/
+/*!
+\file   broad_phase.hpp
+\author Jeong Juyong
+\par    email: jaykop.jy\@gmail.com
+\date   2026/10/17(yy/mm/dd)
+
+\description
+Contains the definition of AABB structure and SweepAndPrune class
+*/
+/******************************************************************************/
+
+#pragma once
+#include <macros.hpp>
+#include <vector>
+#include <vec3.hpp>
+
+jeBegin
+
+class Collider2D;
+
+// axis aligned bounding box on xy plane
+struct AABB {
+
+	vec3 min, max;
+
+	bool overlaps(const AABB& other) const
+	{
+		return min.x <= other.max.x && other.min.x <= max.x
+			&& min.y <= other.max.y && other.min.y <= max.y;
+	}
+
+	bool contains(const AABB& other) const
+	{
+		return min.x <= other.min.x && min.y <= other.min.y
+			&& other.max.x <= max.x && other.max.y <= max.y;
+	}
+
+	float perimeter() const
+	{
+		return 2.f * ((max.x - min.x) + (max.y - min.y));
+	}
+
+	static AABB combine(const AABB& a, const AABB& b)
+	{
+		AABB c;
+		c.min.set(a.min.x < b.min.x ? a.min.x : b.min.x, a.min.y < b.min.y ? a.min.y : b.min.y, 0.f);
+		c.max.set(a.max.x > b.max.x ? a.max.x : b.max.x, a.max.y > b.max.y ? a.max.y : b.max.y, 0.f);
+		return c;
+	}
+};
+
+// candidate pair handed from broad phase to narrow phase
+struct ColliderPair {
+
+	Collider2D* a;
+	Collider2D* b;
+};
+
+using ColliderPairs = std::vector<ColliderPair>;
+
+// incremental sort and sweep along x axis
+class SweepAndPrune {
+
+	jePreventClone(SweepAndPrune)
+
+public:
+
+	SweepAndPrune() {};
+	~SweepAndPrune() {};
+
+	void add(Collider2D* collider);
+	void remove(Collider2D* collider);
+	void clear();
+
+	void find_pairs(ColliderPairs& pairs);
+
+private:
+
+	void drop_removed();
+	void sort_axis();
+
+	// kept sorted by min.x between frames,
+	// so that the insertion sort stays close to linear
+	std::vector<Collider2D*> axis_;
+	std::vector<Collider2D*> active_;
+	std::vector<Collider2D*> removed_;
+	bool resort_ = false;
+};
+
+jeEnd
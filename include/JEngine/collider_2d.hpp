@@ -1,16 +1,27 @@
 #pragma once
 #include <component_builder.hpp>
 #include <component.hpp>
-#include <vector>
+#include <aabb_tree.hpp>
+#include <rigidbody.hpp>
 #include <vec3.hpp>
+#include <mat3.hpp>
+#include <quat.hpp>
 
 jeBegin
 
 class Transform;
+struct ContactManifold;
+
+// the physics works in the local values of the transform,
+// so a collider goes on a root object only
 class Collider2D : public Component {
 
 	jeBaseFriends(Collider2D);
 	friend class PhysicsSystem;
+	friend class SweepAndPrune;
+	friend class RigidBody;
+	friend class BodyStore;
+	friend class ContactCache;
 
 public:
 
@@ -26,7 +37,28 @@ public:
 	ColliderType  coliisionType_ = ColliderType::NONE;
 	Transform* transform;
 
+	// collision filter, a pair is tested only if
+	// each category is in the other's mask
+	unsigned category = 0x0001;
+	unsigned mask = 0xFFFF;
+
 	void init_vertices();
+	const AABB& get_bounds() const { return bounds_; }
+
+	// the local space shape and the world transform cached for the step
+	const vec3* get_vertices() const { return vertices_; }
+	int get_vertex_count() const { return vertexCount_; }
+	const vec3& get_position() const { return position_; }
+	const mat3& get_rotation() const { return rotation_; }
+	bool is_circle() const { return coliisionType_ == ColliderType::CIRCLE; }
+	RigidBody* get_body() const;
+
+	bool is_static() const { return static_; }
+	bool can_collide(const Collider2D* other) const
+	{
+		return (category & other->mask) && (other->category & mask)
+			&& !(is_static() && other->is_static());
+	}
 
 protected:
 
@@ -36,7 +68,41 @@ protected:
 
 private:
 
-	std::vector<vec3> vertices_;
+	static const int MAX_VERTICES = 8;
+
+	bool update_transform();
+	void update_bounds();
+	void sweep_bounds(const vec3& displacement);
+
+	// local space outward edge normals, normals[i] is of the edge from i to i + 1
+	void get_normals(vec3* normals) const;
+
+	// world space queries
+	bool test_point(const vec3& point) const;
+	bool raycast(const vec3& from, const vec3& to, float maxFraction, float& fraction, vec3& normal) const;
+
+	// local space shape
+	vec3 vertices_[MAX_VERTICES];
+	int vertexCount_ = 0;
+	float radius_ = 0.f;
+
+	// world transform, rebuilt once per frame only when the transform changed
+	vec3 position_, scale_;
+	quat orientation_;
+	mat3 rotation_;
+	bool dirty_ = true;
+
+	AABB bounds_;
+	int body_ = -1; // index in the body store
+	bool static_ = true; // no body or a static one, refreshed every step
+	bool swept_ = false;
+
+	// aabb tree proxy
+	int proxyId_ = AABBTree::NULL_NODE;
+	bool staticProxy_ = false;
+
+	int index_ = -1; // in the colliders of the system
+	ContactManifold* contacts_ = nullptr; // head of its manifolds in the cache
 
 };
 
@@ -0,0 +1,36 @@
+/******************************************************************************/
+/*!
+\file   collision_event.hpp
+\author Jeong Juyong
+\par    email: jaykop.jy\@gmail.com
+\date   2026/10/17(yy/mm/dd)
+
+\description
+Contains the definition of CollisionEvent structure
+*/
+/******************************************************************************/
+
+#pragma once
+#include <macros.hpp>
+#include <vector>
+#include <vec3.hpp>
+
+jeBegin
+
+class Collider2D;
+
+// a change of the contact between two colliders in the last frame.
+// sleeping pairs are not tested, so they neither stay nor end
+struct CollisionEvent {
+
+	enum class Type { BEGIN, STAY, END };
+
+	Type type;
+	Collider2D* collider; // belongs to the object receiving the event
+	Collider2D* other;
+	vec3 normal; // points from the other to this
+};
+
+using CollisionEvents = std::vector<CollisionEvent>;
+
+jeEnd
@@ -0,0 +1,95 @@
+/******************************************************************************/
+/*!
+\file   command_buffer.hpp
+\author Jeong Juyong
+\par    email: jaykop.jy\@gmail.com
+\date   2026/10/17(yy/mm/dd)
+
+\description
+Contains the definition of CommandBuffer class
+*/
+/******************************************************************************/
+
+#pragma once
+#include <mutex>
+#include <vector>
+#include <functional>
+#include <assets.hpp>
+
+jeBegin
+
+// structural changes recorded while the systems are iterating,
+// played back together at the sync point of the scene update.
+// every thread records into its own buffer without locking
+class CommandBuffer {
+
+	jePreventClone(CommandBuffer)
+
+	friend class Scene;
+
+public:
+
+	// runs at the playback, after the object is created
+	// and before its components join the systems
+	using Setup = std::function<void(Object*)>;
+
+	// buffer of the calling thread
+	static CommandBuffer& get();
+
+	// the name is optional as in ObjectManager::create_object
+	void create_object(const char* name, const Setup& setup);
+	void remove_object(ObjectHandle handle);
+
+	template <class ComponentType> void add_component(ObjectHandle handle);
+	template <class ComponentType> void remove_component(ObjectHandle handle);
+
+	void add_component(ObjectHandle handle, const char* componentName);
+	void remove_component(ObjectHandle handle, const char* componentName);
+
+	bool empty() const { return recording_.commands.empty(); }
+
+private:
+
+	CommandBuffer() {};
+	~CommandBuffer() {};
+
+	enum class CommandType { CREATE, ADD_COMPONENT, REMOVE_COMPONENT, REMOVE };
+
+	struct Command {
+
+		CommandType type;
+		ObjectHandle handle;
+		const char* typeName; // of the component, the id is found at the playback
+		int name; // offset into the names, -1 if unnamed
+		unsigned setup;
+	};
+
+	// kept between the frames, so recording does not allocate once warmed up
+	struct Record {
+
+		std::vector<Command> commands;
+		std::vector<Setup> setups;
+		std::vector<char> names;
+
+		void clear();
+	};
+
+	void record(CommandType type, ObjectHandle handle, const char* typeName);
+
+	// the buffers of all threads, one kind of command at a time.
+	// what a setup records is played back at the next sync point
+	static void play_back();
+
+	// drops what is left, a scene does not leak its commands into the next one
+	static void clear();
+
+	Record recording_, playing_;
+
+	static std::vector<CommandBuffer*> buffers_;
+	static std::vector<Object*> created_;
+	static std::mutex lock_;
+};
+
+jeEnd
+
+#include <command_buffer.inl>
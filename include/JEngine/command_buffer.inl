@@ -0,0 +1,31 @@
+/******************************************************************************/
+/*!
+\file   command_buffer.inl
+\author Jeong Juyong
+\par    email: jaykop.jy\@gmail.com
+\date   2026/10/17(yy/mm/dd)
+
+\description
+Contains the template methods of CommandBuffer class
+*/
+/******************************************************************************/
+
+#pragma once
+#include <typeinfo>
+#include <command_buffer.hpp>
+
+jeBegin
+
+template <class ComponentType>
+void CommandBuffer::add_component(ObjectHandle handle)
+{
+	record(CommandType::ADD_COMPONENT, handle, typeid(ComponentType).name());
+}
+
+template <class ComponentType>
+void CommandBuffer::remove_component(ObjectHandle handle)
+{
+	record(CommandType::REMOVE_COMPONENT, handle, typeid(ComponentType).name());
+}
+
+jeEnd
@@ -12,6 +12,7 @@ Contains the definition of Component class
 
 #pragma once
 #include <json_parser.hpp>
+#include <memory_pool.hpp>
 
 jeBegin
 
@@ -21,6 +22,8 @@ class Component {
 
 public:
 
+	jeUseMemoryPool
+
 	Object* get_owner() const { return owner_; }
 
 protected:
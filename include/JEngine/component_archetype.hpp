@@ -0,0 +1,138 @@
+/******************************************************************************/
+/*!
+\file   component_archetype.hpp
+\author Jeong Juyong
+\par    email: jaykop.jy\@gmail.com
+\date   2026/10/17(yy/mm/dd)
+
+\description
+Contains the definition of ComponentArchetype and ArchetypeStorage class
+*/
+/******************************************************************************/
+
+#pragma once
+#include <macros.hpp>
+#include <vector>
+#include <map>
+
+jeBegin
+
+class Object;
+class Component;
+class ComponentQuery;
+template <class... ComponentTypes> class ComponentView;
+
+// sorted component type ids
+using Signature = std::vector<unsigned>;
+
+// objects sharing one set of component types.
+// a chunk keeps one column per component type and one of the owners,
+// so a system walks the components of a type without touching the objects.
+// the columns hold pointers, not the components themselves: the systems,
+// the body store and the collision events keep raw component pointers,
+// so a component cannot move with its object. the data sits in the pool
+// of its type in the scene arena instead, one dense slab after another
+class ComponentArchetype {
+
+	jePreventClone(ComponentArchetype)
+
+	friend class ArchetypeStorage;
+
+public:
+
+	static const unsigned CHUNK_SIZE = 128;
+
+	struct Chunk {
+
+		unsigned count = 0;
+		Object* objects[CHUNK_SIZE];
+		std::vector<Component*> components; // column c starts at c * CHUNK_SIZE
+
+		Component** get_column(int column) { return &components[column * CHUNK_SIZE]; }
+	};
+
+	const Signature& get_signature() const { return signature_; }
+	bool has_all(const Signature& types) const;
+
+	// -1 if the type is not in the set
+	int get_column(unsigned typeId) const
+	{
+		return typeId < columnOf_.size() ? columnOf_[typeId] : -1;
+	}
+
+	unsigned size() const { return size_; }
+	unsigned get_chunk_count() const { return static_cast<unsigned>(chunks_.size()); }
+	Chunk& get_chunk(unsigned index) { return *chunks_[index]; }
+
+	Component*& at(unsigned row, int column)
+	{
+		return chunks_[row / CHUNK_SIZE]->components[column * CHUNK_SIZE + row % CHUNK_SIZE];
+	}
+
+	Object* get_object(unsigned row) const
+	{
+		return chunks_[row / CHUNK_SIZE]->objects[row % CHUNK_SIZE];
+	}
+
+private:
+
+	ComponentArchetype(const Signature& signature);
+	~ComponentArchetype();
+
+	unsigned add(Object* object);
+
+	// the last object fills the hole, returns it or nullptr if it was the last one
+	Object* remove(unsigned row);
+
+	Signature signature_;
+	std::vector<int> columnOf_; // indexed by the type id
+	std::vector<Chunk*> chunks_; // emptied chunks are kept for the reuse
+	unsigned size_ = 0;
+};
+
+// every object is in the archetype of its component set,
+// and moves to another one when a component is added or removed.
+// components never move, only their pointers do.
+// each scene keeps its own storage in its object map
+class ArchetypeStorage {
+
+	jePreventClone(ArchetypeStorage)
+
+	friend class Object;
+	template <class... ComponentTypes> friend class ComponentView;
+
+public:
+
+	ArchetypeStorage() {};
+	~ArchetypeStorage();
+
+	// callback(Object*, ComponentTypes*...) for every object having all the types,
+	// archetype by archetype and chunk by chunk. no component may be added or
+	// removed inside of the callback
+	template <class... ComponentTypes, class Callback>
+	void for_each(Callback callback);
+
+	const std::vector<ComponentArchetype*>& get_archetypes() const { return archetypes_; }
+
+private:
+
+	// one query per requested type list, matched against every new archetype
+	ComponentQuery* get_query(const unsigned* ids, unsigned count);
+
+	ComponentArchetype* find_or_create(const Signature& signature);
+
+	void add(Object* object);
+	void remove(Object* object);
+	void move(Object* object, ComponentArchetype* to);
+
+	void add_component(Object* object, unsigned typeId, Component* component);
+	Component* remove_component(Object* object, unsigned typeId);
+
+	std::vector<ComponentArchetype*> archetypes_;
+	std::map<Signature, ComponentArchetype*> signatures_;
+	std::map<std::vector<unsigned>, ComponentQuery*> queries_;
+};
+
+jeEnd
+
+#include <component_archetype.inl>
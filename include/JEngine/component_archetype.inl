@@ -0,0 +1,26 @@
+/******************************************************************************/
+/*!
+\file   component_archetype.inl
+\author Jeong Juyong
+\par    email: jaykop.jy\@gmail.com
+\date   2026/10/17(yy/mm/dd)
+
+\description
+Contains the template methods of ArchetypeStorage class
+*/
+/******************************************************************************/
+
+#pragma once
+#include <component_archetype.hpp>
+#include <component_query.hpp>
+
+jeBegin
+
+template <class... ComponentTypes, class Callback>
+void ArchetypeStorage::for_each(Callback callback)
+{
+	// the query is created once per type list, then found in the map
+	ComponentView<ComponentTypes...>(*this).for_each(callback);
+}
+
+jeEnd
@@ -18,6 +18,7 @@ jeBegin
 class Object;
 class Behavior;
 class Component;
+class MemoryArena;
 
 class ComponentBuilder {
 	
@@ -33,7 +34,7 @@ protected:
 
 private:
 
-	virtual Component* create_component(Object* owner) const = 0;
+	virtual Component* create_component(Object* owner, MemoryArena& arena) const = 0;
 
 };
 
@@ -43,21 +44,22 @@ private:
 #define jeConcat(a, b)			a ## b
 #define jeDefineComponentBuilder(c)					\
 	jeConcat(c, Builder)::jeConcat(c, Builder)() {} \
-	Component* jeConcat(c, Builder)::create_component(Object* owner) const { return new (c)(owner);}
+	Component* jeConcat(c, Builder)::create_component(Object* owner, MemoryArena& arena) const { return new (arena.get_pool<c>()) c(owner);}
 #define jeDeclareComponentBuilder(c)	\
 	class jeConcat(c, Builder) : public ComponentBuilder { \
 	friend class AssetManager; \
+	friend class ComponentManager; \
 	jeConcat(c, Builder)(); \
 	~jeConcat(c, Builder)() {}; \
 	jeConcat(c, Builder)(const jeConcat(c, Builder)& /*copy*/) = delete; \
 	jeConcat(c, Builder)& operator=(const jeConcat(c, Builder)& /*copy*/) = delete; \
 	jeConcat(c, Builder)(jeConcat(c, Builder) && /*copy*/) = delete; \
 	jeConcat(c, Builder)& operator=(jeConcat(c, Builder) && /*copy*/) = delete; \
-	Component* create_component(Object* owner) const override; \
+	Component* create_component(Object* owner, MemoryArena& arena) const override; \
 	}
 #define jeDefineUserComponentBuilder(c)	\
 	jeConcat(c, Builder)::jeConcat(c, Builder)() {} \
-	Behavior* jeConcat(c, Builder)::create_component(Object* owner) const { return new (c)(owner); } 
+	Behavior* jeConcat(c, Builder)::create_component(Object* owner, MemoryArena& arena) const { return new (arena.get_pool<c>()) c(owner); } 
 #define jeDeclareUserComponentBuilder(c)	\
 	class jeConcat(c, Builder) : public ComponentBuilder { \
 	friend class JEngine; \
@@ -67,7 +69,7 @@ private:
 	jeConcat(c, Builder)& operator=(const jeConcat(c, Builder)& /*copy*/) = delete; \
 	jeConcat(c, Builder)(jeConcat(c, Builder) && /*copy*/) = delete; \
 	jeConcat(c, Builder)& operator=(jeConcat(c, Builder) && /*copy*/) = delete; \
-	Behavior* create_component(Object* owner) const override; \
+	Behavior* create_component(Object* owner, MemoryArena& arena) const override; \
 	}
 
 jeEnd
\ No newline at end of file
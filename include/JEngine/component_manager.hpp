@@ -12,11 +12,13 @@ Contains the definition of ComponentManager class
 
 #pragma once
 #include <macros.hpp>
+#include <mutex>
 #include <unordered_map>
 
 jeBegin
 
 class Component;
+class MemoryArena;
 class ComponentBuilder;
 
 class ComponentManager {
@@ -30,17 +32,36 @@ class ComponentManager {
 	friend class JEngine;
 	friend class Object;
 	friend class AssetManager;
+	friend class ArchetypeStorage;
+	friend class CommandBuffer;
+	friend class SystemNode;
+	template <class... ComponentTypes> friend class ComponentView;
 
 	using Directory = std::unordered_map<std::string, std::string>;
 	using BuilderMap = std::unordered_map<std::string, ComponentBuilder*>;
+	using TypeIds = std::unordered_map<std::string, unsigned>;
+
+public:
+
+	// AssetManager registers every engine component, a tool running
+	// a system without it registers the few it needs here
+	template <class ComponentType, class BuilderType>
+	static void register_component(const char* componentName);
 
 private:
 
-	static Component* create_component(const char* componentName, Object* owner);
+	static Component* create_component(const char* componentName, Object* owner, MemoryArena& arena);
 
 	static const char* key_to_type(const char* name);
 	static const char* type_to_key(const char* type);
 
+	// dense id of a component type, given in the order of the first use
+	static unsigned get_type_id(const char* type);
+
+	// same id as above, looked up once per type
+	template <class ComponentType>
+	static unsigned get_type_id();
+
 	static void clear_builders();
 
 	template <class ComponentType>
@@ -48,6 +69,8 @@ private:
 
 	static BuilderMap builderMap_;
 	static Directory types_, keys_;
+	static TypeIds typeIds_;
+	static std::mutex typeLock_;
 	 
 };
 
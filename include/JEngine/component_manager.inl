@@ -34,6 +34,22 @@ void ComponentManager::register_builder(
 	// add key and type name
 	types_.insert(Directory::value_type(componentName, typeName));
 	keys_.insert(Directory::value_type(typeName, componentName));
+
+	// the id is given before the workers start using it
+	get_type_id<ComponentType>();
+}
+
+template <class ComponentType, class BuilderType>
+void ComponentManager::register_component(const char* componentName)
+{
+	register_builder<ComponentType>(componentName, new BuilderType);
+}
+
+template <class ComponentType>
+unsigned ComponentManager::get_type_id()
+{
+	static const unsigned id = get_type_id(typeid(ComponentType).name());
+	return id;
 }
 	
 jeEnd
\ No newline at end of file
@@ -0,0 +1,93 @@
+/******************************************************************************/
+/*!
+\file   component_query.hpp
+\author Jeong Juyong
+\par    email: jaykop.jy\@gmail.com
+\date   2026/10/17(yy/mm/dd)
+
+\description
+Contains the definition of ComponentQuery class and ComponentView template class
+*/
+/******************************************************************************/
+
+#pragma once
+#include <utility>
+#include <component_archetype.hpp>
+
+jeBegin
+
+// archetypes having all of the component types.
+// the list only grows when a new archetype matches, objects moving
+// between the archetypes never touch it
+class ComponentQuery {
+
+	jePreventClone(ComponentQuery)
+
+	friend class ArchetypeStorage;
+	template <class... ComponentTypes> friend class ComponentView;
+
+public:
+
+	const std::vector<ComponentArchetype*>& get_archetypes() const { return archetypes_; }
+	unsigned size() const;
+
+private:
+
+	ComponentQuery(const unsigned* ids, unsigned count);
+	~ComponentQuery() {};
+
+	void match(ComponentArchetype* archetype);
+
+	// column of the i-th requested type in the a-th archetype
+	int get_column(unsigned archetype, unsigned i) const { return columns_[archetype * ids_.size() + i]; }
+
+	std::vector<unsigned> ids_; // in the requested order
+	Signature types_;
+	std::vector<ComponentArchetype*> archetypes_;
+	std::vector<int> columns_;
+};
+
+// packed component pointers of one type in a chunk,
+// each one still a load into the pool of the type
+template <class ComponentType>
+struct ComponentSpan {
+
+	Component** data;
+	unsigned count;
+
+	ComponentType* operator[](unsigned index) const { return static_cast<ComponentType*>(data[index]); }
+};
+
+// typed access to the cached query of the component types,
+// cheap to keep around as a member of a system.
+// the query belongs to the storage, so a view lives as long as its scene
+template <class... ComponentTypes>
+class ComponentView {
+
+public:
+
+	// sees nothing until bound to a storage
+	ComponentView() : query_(nullptr) {};
+	explicit ComponentView(ArchetypeStorage& storage);
+
+	// callback(Object*, ComponentTypes*...) for every matching object
+	template <class Callback>
+	void for_each(Callback callback) const;
+
+	// callback(unsigned count, Object** objects, ComponentSpan<ComponentTypes>...) per chunk
+	template <class Callback>
+	void for_each_chunk(Callback callback) const;
+
+	unsigned size() const { return query_ ? query_->size() : 0; }
+
+private:
+
+	template <class Callback, size_t... Index>
+	void visit(Callback& callback, std::index_sequence<Index...>) const;
+
+	ComponentQuery* query_;
+};
+
+jeEnd
+
+#include <component_query.inl>
@@ -0,0 +1,69 @@
+/******************************************************************************/
+/*!
+\file   component_query.inl
+\author Jeong Juyong
+\par    email: jaykop.jy\@gmail.com
+\date   2026/10/17(yy/mm/dd)
+
+\description
+Contains the template methods of ComponentView class
+*/
+/******************************************************************************/
+
+#pragma once
+#include <component_query.hpp>
+#include <component_manager.hpp>
+
+jeBegin
+
+template <class... ComponentTypes>
+ComponentView<ComponentTypes...>::ComponentView(ArchetypeStorage& storage)
+{
+	static_assert(sizeof...(ComponentTypes) > 0, "At least one component type is needed!");
+
+	const unsigned ids[] = { ComponentManager::get_type_id<ComponentTypes>()... };
+	query_ = storage.get_query(ids, sizeof...(ComponentTypes));
+}
+
+template <class... ComponentTypes>
+template <class Callback>
+void ComponentView<ComponentTypes...>::for_each(Callback callback) const
+{
+	for_each_chunk([&callback](unsigned count, Object** objects, ComponentSpan<ComponentTypes>... columns) {
+		for (unsigned i = 0; i < count; ++i)
+			callback(objects[i], columns[i]...);
+	});
+}
+
+template <class... ComponentTypes>
+template <class Callback>
+void ComponentView<ComponentTypes...>::for_each_chunk(Callback callback) const
+{
+	visit(callback, std::index_sequence_for<ComponentTypes...>());
+}
+
+template <class... ComponentTypes>
+template <class Callback, size_t... Index>
+void ComponentView<ComponentTypes...>::visit(Callback& callback, std::index_sequence<Index...>) const
+{
+	if (!query_)
+		return;
+
+	const auto& archetypes = query_->archetypes_;
+	for (unsigned a = 0; a < archetypes.size(); ++a)
+	{
+		ComponentArchetype* archetype = archetypes[a];
+		for (unsigned c = 0; c < archetype->get_chunk_count(); ++c)
+		{
+			// the filled chunks come first
+			ComponentArchetype::Chunk& chunk = archetype->get_chunk(c);
+			if (!chunk.count)
+				break;
+
+			callback(chunk.count, chunk.objects,
+				ComponentSpan<ComponentTypes>{ chunk.get_column(query_->get_column(a, Index)), chunk.count }...);
+		}
+	}
+}
+
+jeEnd
@@ -0,0 +1,102 @@
+/******************************************************************************/
+/*!
+\file   contact_cache.hpp
+\author Jeong Juyong
+\par    email: jaykop.jy\@gmail.com
+\date   2026/10/17(yy/mm/dd)
+
+\description
+Contains the definition of ContactManifold structure and ContactCache class
+*/
+/******************************************************************************/
+
+#pragma once
+#include <macros.hpp>
+#include <unordered_map>
+#include <vector>
+#include <vec3.hpp>
+
+jeBegin
+
+class Collider2D;
+
+// contact between two colliders kept over the steps
+struct ContactManifold {
+
+	Collider2D* a = nullptr;
+	Collider2D* b = nullptr;
+	vec3 normal; // from b to a
+	float normalImpulse = 0.f; // accumulated, never negative
+	unsigned lastStep = 0;
+	unsigned id = 0; // in the order of the creation
+
+	// links in the lists of a (0) and b (1)
+	ContactManifold* prev[2] = { nullptr, nullptr };
+	ContactManifold* next[2] = { nullptr, nullptr };
+};
+
+// manifolds keyed by collider pair, regardless of the order in the pair.
+// each collider also heads a list of its own manifolds,
+// so removing it touches only the pairs it is in
+class ContactCache {
+
+	jePreventClone(ContactCache)
+
+public:
+
+	ContactCache() {};
+	~ContactCache() {};
+
+	// returns true if the manifold existed already
+	bool find_or_add(Collider2D* a, Collider2D* b, ContactManifold*& manifold);
+
+	// the other colliders of the removed manifolds are added to touching
+	void remove(Collider2D* collider, std::vector<Collider2D*>& touching);
+	// the manifolds not touched in the step are copied to removed,
+	// in the order of the creation whatever the order of the map
+	void remove_stale(unsigned step, std::vector<ContactManifold>& removed);
+	void clear();
+
+	unsigned size() const { return static_cast<unsigned>(manifolds_.size()); }
+
+	// the sleeping pairs too, which skip the narrow phase
+	template <class Visit>
+	void for_each(Visit visit) const
+	{
+		for (const auto& m : manifolds_)
+			visit(m.second);
+	}
+
+private:
+
+	struct Key {
+
+		Collider2D* first;
+		Collider2D* second;
+
+		bool operator==(const Key& other) const
+		{
+			return first == other.first && second == other.second;
+		}
+	};
+
+	struct KeyHash {
+
+		size_t operator()(const Key& key) const;
+	};
+
+	static Key make_key(Collider2D* a, Collider2D* b);
+	static int get_side(const ContactManifold* manifold, const Collider2D* collider)
+	{
+		return manifold->a == collider ? 0 : 1;
+	}
+
+	void link(ContactManifold* manifold);
+	void unlink(ContactManifold* manifold);
+
+	// nodes never move, so the manifold pointers survive the insertions
+	std::unordered_map<Key, ContactManifold, KeyHash> manifolds_;
+	unsigned nextId_ = 0;
+};
+
+jeEnd
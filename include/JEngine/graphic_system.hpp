@@ -16,6 +16,7 @@ Contains the definition of GraphicSystem class
 #include <vector>
 #include <vec4.hpp>
 #include <renderer.hpp>
+#include <component_query.hpp>
 
 jeBegin
 
@@ -41,7 +42,7 @@ class GraphicSystem {
 
 	using Renderers = std::vector<Renderer*>;
 	using Cameras = std::vector<Camera*>;
-	using Lights = std::vector<Light*>;
+	using Lights = ComponentView<Light>; // every light of the scene
 	using Shaders = std::vector<Shader*>;
 
 	// enum class Target { SCREEN, TEXT, END };
@@ -103,9 +104,6 @@ private:
 	static void add_camera(Camera* camera);
 	static void remove_camera(Camera* camera);
 
-	static void add_light(Light* light);
-	static void remove_light(Light* light);
-
 	static void pause();
 	static void resume();
 
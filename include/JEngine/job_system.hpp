@@ -0,0 +1,130 @@
+/******************************************************************************/
+/*!
+\file   job_system.hpp
+\author Jeong Juyong
+\par    email: jaykop.jy\@gmail.com
+\date   2026/10/17(yy/mm/dd)
+
+\description
+Contains the definition of JobSystem class and JobCounter structure
+*/
+/******************************************************************************/
+
+#pragma once
+#include <macros.hpp>
+#include <mutex>
+#include <deque>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <functional>
+#include <condition_variable>
+
+jeBegin
+
+using JobFunction = std::function<void()>;
+
+struct JobCounter;
+
+// a job and the counter it reports to when it is done
+struct Job {
+
+	JobFunction function;
+	JobCounter* counter = nullptr;
+};
+
+// number of unfinished jobs of a group.
+// jobs can wait for the group to finish with JobSystem::run_after
+struct JobCounter {
+
+	JobCounter() {};
+	jePreventClone(JobCounter)
+
+	bool is_done() const { return pending_ == 0; }
+
+private:
+
+	friend class JobSystem;
+
+	std::atomic<unsigned> pending_{ 0 };
+	std::mutex lock_;
+	std::vector<Job> continuations_;
+};
+
+// pool of workers, each with its own deque.
+// a worker takes the newest job of its own deque and steals
+// the oldest one of the others, the main thread is the worker 0
+// and helps while it waits. jobs touching GL stay on the main thread
+class JobSystem {
+
+	// Prevent to clone this class
+	JobSystem() = delete;
+	~JobSystem() = delete;
+
+	jePreventClone(JobSystem)
+
+	friend class Application;
+	friend class SceneManager;
+
+public:
+
+	using RangeJob = std::function<void(unsigned, unsigned, unsigned)>; // chunk, begin, end
+
+	static void run(const JobFunction& function, JobCounter* counter = nullptr);
+
+	// starts when the dependency counter drops to zero
+	static void run_after(JobCounter& dependency, const JobFunction& function, JobCounter* counter = nullptr);
+
+	// runs on the main thread, at the next update or while it waits
+	static void run_on_main(const JobFunction& function, JobCounter* counter = nullptr);
+
+	// works on the other jobs until the counter drops to zero
+	static void wait(JobCounter& counter);
+
+	// count split into contiguous chunks, the first one runs on the calling thread.
+	// the chunk index is the same for any number of threads
+	static void parallel_for(unsigned count, unsigned chunks, const RangeJob& job);
+
+	// workers and the main thread, jobs run inline until the system is initialized
+	static unsigned get_thread_count() { return workers_.empty() ? 1 : static_cast<unsigned>(workers_.size()); }
+	static bool is_main_thread() { return std::this_thread::get_id() == mainThread_; }
+	static unsigned get_thread_index() { return workerIndex_; }
+
+	// started and stopped by the application, or by a tool running without one.
+	// 0 to use the hardware concurrency
+	static void initialize(unsigned threadCount = 0);
+	static void close();
+
+private:
+
+	struct Worker {
+
+		std::mutex lock;
+		std::deque<Job> jobs;
+	};
+
+	static void update();
+
+	static void enqueue(const Job& job);
+	static void finish(JobCounter* counter);
+	static void execute(Job& job);
+	static bool execute_one(unsigned index);
+
+	static bool pop(unsigned index, Job& job);
+	static bool steal(unsigned index, Job& job);
+	static bool pop_main(Job& job);
+
+	static void work(unsigned index);
+
+	static std::vector<Worker*> workers_;
+	static std::vector<std::thread> threads_;
+	static std::deque<Job> mainJobs_;
+	static std::mutex mainLock_, sleepLock_;
+	static std::condition_variable wake_;
+	static std::atomic<unsigned> queued_;
+	static std::atomic<bool> running_;
+	static std::thread::id mainThread_;
+	static thread_local unsigned workerIndex_;
+};
+
+jeEnd
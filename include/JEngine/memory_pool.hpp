@@ -0,0 +1,117 @@
+/******************************************************************************/
+/*!
+\file   memory_pool.hpp
+\author Jeong Juyong
+\par    email: jaykop.jy\@gmail.com
+\date   2026/10/17(yy/mm/dd)
+
+\description
+Contains the definition of MemoryPool and MemoryArena class
+*/
+/******************************************************************************/
+
+#pragma once
+#include <macros.hpp>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <cstddef>
+
+jeBegin
+
+// fixed size blocks carved out of slabs, freed blocks are linked for the reuse.
+// every block starts with a header pointing at its pool,
+// so a pooled instance finds its way back on delete
+class MemoryPool {
+
+	jePreventClone(MemoryPool)
+
+	friend class MemoryArena;
+
+public:
+
+	static const unsigned BLOCKS_PER_SLAB = 64;
+
+	void* allocate();
+	void free(void* block);
+
+	// drops every slab at once, the blocks must not be in use anymore
+	void release();
+
+	const char* get_name() const { return name_; }
+	size_t get_block_size() const { return blockSize_; }
+	unsigned get_used() const { return used_; }
+	unsigned get_high_water() const { return highWater_; }
+	unsigned get_capacity() const { return static_cast<unsigned>(slabs_.size()) * BLOCKS_PER_SLAB; }
+
+	// used by the pooled operators, the pool is nullptr for the global heap
+	static void* allocate(size_t size, MemoryPool* pool);
+	static void deallocate(void* instance);
+
+private:
+
+	struct Header {
+
+		MemoryPool* pool;
+		Header* next; // free list link
+	};
+
+	// keeps the instance after the header aligned
+	static const size_t HEADER_SIZE = (sizeof(Header) + alignof(std::max_align_t) - 1)
+		/ alignof(std::max_align_t) * alignof(std::max_align_t);
+
+	MemoryPool(const char* name, size_t size);
+	~MemoryPool();
+
+	void add_slab();
+
+	const char* name_;
+	size_t blockSize_;
+	Header* freeList_ = nullptr;
+	std::vector<char*> slabs_;
+	unsigned used_ = 0, highWater_ = 0;
+};
+
+// one pool per type, owned by a scene.
+// unloading the scene releases the slabs of every pool together
+class MemoryArena {
+
+	jePreventClone(MemoryArena)
+
+public:
+
+	MemoryArena() {};
+	~MemoryArena();
+
+	template <class Type>
+	MemoryPool& get_pool();
+
+	void release();
+
+	// null where the type was never allocated in this arena
+	const std::vector<MemoryPool*>& get_pools() const { return pools_; }
+
+private:
+
+	// the same for a type in every arena, taken on the first use from any thread
+	template <class Type>
+	static unsigned get_index();
+
+	static std::atomic<unsigned> indexCount_;
+
+	// the first pool of a type may be made on a worker, like by a builder
+	std::mutex lock_;
+	std::vector<MemoryPool*> pools_;
+};
+
+// class specific operators routing new and delete through a pool,
+// new (pool) Type(...) takes a block of the pool and plain new the global heap
+#define jeUseMemoryPool \
+	static void* operator new(size_t size) { return MemoryPool::allocate(size, nullptr); } \
+	static void* operator new(size_t size, MemoryPool& pool) { return MemoryPool::allocate(size, &pool); } \
+	static void operator delete(void* instance) { MemoryPool::deallocate(instance); } \
+	static void operator delete(void* instance, MemoryPool&) { MemoryPool::deallocate(instance); }
+
+jeEnd
+
+#include <memory_pool.inl>
@@ -0,0 +1,41 @@
+/******************************************************************************/
+/*!
+\file   memory_pool.inl
+\author Jeong Juyong
+\par    email: jaykop.jy\@gmail.com
+\date   2026/10/17(yy/mm/dd)
+
+\description
+Contains the template methods of MemoryArena class
+*/
+/******************************************************************************/
+
+#pragma once
+#include <typeinfo>
+#include <memory_pool.hpp>
+
+jeBegin
+
+template <class Type>
+unsigned MemoryArena::get_index()
+{
+	static const unsigned index = indexCount_++;
+	return index;
+}
+
+template <class Type>
+MemoryPool& MemoryArena::get_pool()
+{
+	unsigned index = get_index<Type>();
+
+	std::lock_guard<std::mutex> lock(lock_);
+	if (pools_.size() <= index)
+		pools_.resize(index + 1, nullptr);
+
+	if (!pools_[index])
+		pools_[index] = new MemoryPool(typeid(Type).name(), sizeof(Type));
+
+	return *pools_[index];
+}
+
+jeEnd
@@ -11,23 +11,26 @@ Contains the definition of Object class
 /******************************************************************************/
 
 #pragma once
-#include <macros.hpp>
-#include <unordered_map>
+#include <assets.hpp>
 
 jeBegin
 
 class Object;
 class Component;
-using Children = std::unordered_map<std::string, Object*>;
-using Components = std::unordered_map<std::string, Component*>;
+class ComponentArchetype;
+using Children = std::vector<ObjectHandle>; // unnamed children too
 
 class Object {
 
 	friend class ObjectManager;
+	friend class CommandBuffer;
+	friend class ArchetypeStorage;
+	friend class TransformSystem;
 
 public:
 	
 	int get_id() const { return id_; }
+	ObjectHandle get_handle() const { return handle_; }
 	void register_components();
 
 	const char* get_name() const;
@@ -52,20 +55,45 @@ public:
 
 private:
 
-	Object(const char* name);
+	Object(const char* name, ObjectMap& objects);
 	~Object();
 
+	jeUseMemoryPool
+
 	void set_parent(Object* parent) { parent_ = parent; }
 
+	// nullptr if no live child has the name
+	Object* find_child(const char* name) const;
+
 	void clear_component();
 	void clear_children();
 
+	// components live in the archetype of the component set,
+	// the lookup mirrors them by the type id
+	Component* find_component(unsigned typeId) const
+	{
+		return typeId < lookup_.size() ? lookup_[typeId] : nullptr;
+	}
+
+	void attach_component(unsigned typeId, const char* typeName);
+	void detach_component(unsigned typeId);
+
+	// a deferred addition joins the systems at once if the object already did
+	void attach_live_component(const char* typeName);
+
 	int id_ = -1;
+	ObjectHandle handle_;
+	unsigned order_ = 0; // in the scene object list
 	bool active_ = true;
+	bool registered_ = false;
 	Object* parent_ = nullptr;
-	std::string name_;
+	const char* name_; // interned in the name index of the scene
+	MemoryArena* arena_ = nullptr; // of the scene, the components come from here too
+	ArchetypeStorage* storage_ = nullptr; // of the scene too
 	Children children_;
-	Components components_;
+	ComponentArchetype* archetype_ = nullptr;
+	unsigned row_ = 0;
+	std::vector<Component*> lookup_;
 
 	Object() = delete;
 
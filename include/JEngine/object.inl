@@ -19,50 +19,32 @@ jeBegin
 template <class ComponentType>
 void Object::add_component() {
 
-	const char* typeName = typeid(ComponentType).name();
-	auto found = components_.find(typeName);
-	if (found != components_.end()) {
-		jeDebugPrint("Trying to add an existing component!");
-		return;
-	}
-
-	Component* newComponent = ComponentManager::create_component(typeName, this);
-	components_.insert(Components::value_type(typeName, newComponent));
+	attach_component(ComponentManager::get_type_id<ComponentType>(), typeid(ComponentType).name());
 }
 
 template <class ComponentType>
 ComponentType* Object::get_component() {
 
-	const char* typeName = typeid(ComponentType).name();
-	auto found = components_.find(typeName);
+	Component* found = find_component(ComponentManager::get_type_id<ComponentType>());
 
-	if (found == components_.end()) {
+	if (!found) {
 		jeDebugPrint("No such name of component!");
 		return nullptr;
 	}
 
-	return reinterpret_cast<ComponentType*>(found->second);
+	return static_cast<ComponentType*>(found);
 }
 
 template <class ComponentType>
 bool Object::has_component() {
 
-	const char* typeName = typeid(ComponentType).name();
-	auto found = components_.find(typeName);
-	
-	return found != components_.end();
+	return find_component(ComponentManager::get_type_id<ComponentType>()) != nullptr;
 }
 
 template <class ComponentType>
 void Object::remove_component() {
 
-	const char* typeName = ComponentManager::key_to_type(typeid(ComponentType).name());
-	auto found = components_.find(typeName);
-
-	DEBUG_ASSERT(found != components_.end(), "No such name of component!");
-
-	delete found->second;
-	found->second = nullptr;
+	detach_component(ComponentManager::get_type_id<ComponentType>());
 }
 
 jeEnd
\ No newline at end of file
@@ -28,22 +28,46 @@ class ObjectManager {
 
 public:
 
-	static Object* create_object(const char* name);
+	// the name is optional, unnamed objects are found by their handles
+	static Object* create_object(const char* name = nullptr);
 	static void remove_object(const char* name);
 	static void remove_object(Object* object);
+	static void remove_object(ObjectHandle handle);
 	static Object* get_object(const char* name);
 	static bool has_object(const char* name);
 	static void clear_objects();
 
+	// nullptr if the object was removed
+	static Object* get_object(ObjectHandle handle);
+	static bool has_object(ObjectHandle handle);
+
 	static ObjectMap* get_objects();
 
+	// a scene binds its own map, a tool running without one binds it here
+	static void set_objects(ObjectMap* objects);
+
 private:
 
+	struct Slot {
+
+		Object* object = nullptr;
+		unsigned generation = 0;
+		unsigned next = ObjectHandle::NULL_INDEX; // free list link
+	};
+
 	static int assign_id();
 
+	static ObjectHandle allocate_slot(Object* object);
+	static void free_slot(ObjectHandle handle);
+
 	static int idGenerator_;
 	static ObjectMap* objects_;
 
+	// shared by all the scenes, so a handle stays unique
+	// while a paused scene keeps its objects
+	static std::vector<Slot> slots_;
+	static unsigned freeSlot_;
+
 };
 
 jeEnd
\ No newline at end of file
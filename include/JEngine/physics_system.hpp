@@ -13,6 +13,13 @@ Contains the definition of PhysicsSystem class
 #pragma once
 #include <macros.hpp>
 #include <vector>
+#include <atomic>
+#include <mutex>
+#include <broad_phase.hpp>
+#include <aabb_tree.hpp>
+#include <contact_cache.hpp>
+#include <body_store.hpp>
+#include <collision_event.hpp>
 
 struct vec3;
 struct mat3;
@@ -31,30 +38,169 @@ class PhysicsSystem {
 	friend class Collider2D;
 	friend class RigidBody;
 
-	using Bodies = std::vector<RigidBody*>;
 	using Colliders = std::vector<Collider2D*>;
 
+	// narrow phase result, resolved later in pair order
+	struct Contact {
+		unsigned pair;
+		int a, b; // body indices
+		vec3 N;
+		float t;
+		ContactManifold* manifold;
+		float target; // relative normal displacement after the response
+		float friction, glue;
+		unsigned color;
+	};
+
+	using Contacts = std::vector<Contact>;
+
 public:
 
-	static bool is_collided(Collider2D* aCollider, Collider2D* bCollider,
-		RigidBody* aBody, RigidBody* bBody, vec3& N, float& t);
+	enum class BroadPhase { SWEEP_AND_PRUNE, AABB_TREE };
 
-private:
+	// per frame counters
+	struct Stats {
+		unsigned colliders = 0;
+		unsigned candidates = 0; // pairs reported by broad phase
+		unsigned contacts = 0; // pairs confirmed by narrow phase
+		unsigned steps = 0; // fixed steps taken in the last frame
+		unsigned awake = 0, asleep = 0; // dynamic bodies
+		unsigned manifolds = 0, warmStarted = 0; // cached contacts
+		unsigned colors = 0; // independent contact batches
+	};
 
-	static void add_collider(Collider2D* collider);
-	static void add_rigidbody(RigidBody* rigidbody);
+	static const Stats& get_stats();
+
+	// contacts begun, kept and ended over the steps of the last frame,
+	// in the order of the steps
+	static const CollisionEvents& get_collision_events();
+
+	static float get_alpha();
+
+	static BroadPhase broadPhase;
+
+	// fixed time step settings
+	static float fixedStep;
+	static int maxSubSteps;
+
+	// a body resting below the threshold for the given steps falls asleep
+	static float sleepThreshold;
+	static int stepsToSleep;
+
+	// start the contacts with the impulses of the last step
+	static bool warmStarting;
+
+	// contact solver passes per step
+	static int iterations;
+	static int positionIterations;
 
+	// narrow phase workers, 0 to use the threads of the job system
+	static unsigned threadCount;
+
+	static bool is_collided(Collider2D* aCollider, Collider2D* bCollider,
+		RigidBody* aBody, RigidBody* bBody, vec3& N, float& t);
+
+	// driven by the scene, a tool running the physics without one
+	// calls them in the same order
 	static void initialize();
 	static void update(float dt);
 	static void close();
 
-	static bool interval_intersect(const std::vector<vec3>& A, const std::vector<vec3>& B, const vec3& xAxis, 
-		const vec3& xOffset, const vec3& xVel, const mat3& xOri, float& tAxis, const float tMax);
-	static void get_interval(const std::vector<vec3>& vertices, const vec3& xAxis, float& min, float& max);
+	// the candidate pairs of the last broad phase
+	static const ColliderPairs& get_candidate_pairs() { return pairs_; }
+
+	// world queries, only the colliders whose category is in the mask are reported.
+	// they see the colliders as of the end of the last step, the first query
+	// after a step refits the trees once and the rest only read them,
+	// so any number of them may run at once
+	struct RaycastHit {
+		Collider2D* collider = nullptr;
+		vec3 point, normal;
+		float fraction = 1.f; // along the segment
+	};
+
+	struct Segment {
+		vec3 from, to;
+	};
+
+	using QueryResult = std::vector<Collider2D*>;
+
+	static bool raycast(const vec3& origin, const vec3& direction, float distance, RaycastHit& hit, unsigned mask = 0xFFFF);
+	static bool segment_cast(const vec3& from, const vec3& to, RaycastHit& hit, unsigned mask = 0xFFFF);
+	static void query_aabb(const AABB& aabb, QueryResult& result, unsigned mask = 0xFFFF);
+	static void query_point(const vec3& point, QueryResult& result, unsigned mask = 0xFFFF);
+
+	// many queries at once, spread over the workers
+	static void segment_cast(const std::vector<Segment>& segments, std::vector<RaycastHit>& hits, unsigned mask = 0xFFFF);
+	static void query_aabb(const std::vector<AABB>& aabbs, std::vector<QueryResult>& results, unsigned mask = 0xFFFF);
+	static void query_point(const std::vector<vec3>& points, std::vector<QueryResult>& results, unsigned mask = 0xFFFF);
+
+private:
+
+	static void add_collider(Collider2D* collider);
+	static void add_rigidbody(RigidBody* rigidbody);
+	static void remove_collider(Collider2D* collider);
+	static void remove_rigidbody(RigidBody* rigidbody);
+
+	static void step(float dt);
+
+	static unsigned get_worker_count(unsigned count, unsigned minPerWorker);
+
+	static void sync_bodies();
+	static void integrate();
+	static void sync_transforms();
+
+	static void warm_start();
+	static void color_contacts();
+	static void solve_contacts();
+	static void solve_batches(bool position);
+	static void solve_collision(Contact& c);
+	static void solve_overlap(const Contact& c);
+	static void move_to_impact();
+	static void apply_impulse(int a, int b, const vec3& P);
+	static void update_islands();
+	static void wake_islands();
+	static void join_islands(int a, int b);
+	static int find_island(int body);
+	static void find_contacts(unsigned begin, unsigned end, Contacts& contacts);
+	static void sync_proxy(Collider2D* collider);
+	static void find_tree_pairs();
+	static void refit_query_tree();
+	static bool cast_segment(const vec3& from, const vec3& to, RaycastHit& hit, unsigned mask);
+	static void find_overlaps(const AABB& aabb, QueryResult& result, unsigned mask);
+	static void find_point(const vec3& point, QueryResult& result, unsigned mask);
+
+	// shape pair tests, displacement is the one of A relative to B,
+	// N points from B to A and t < 0 is an overlap
+	static bool collide(Collider2D* a, Collider2D* b, const vec3& displacement, vec3& N, float& t);
+	static bool polygon_polygon(Collider2D* a, Collider2D* b, const vec3& displacement, vec3& N, float& t);
+	static bool circle_circle(Collider2D* a, Collider2D* b, const vec3& displacement, vec3& N, float& t);
+	static bool circle_polygon(Collider2D* a, Collider2D* b, const vec3& displacement, vec3& N, float& t);
+
+	static bool interval_intersect(float min0, float max0, float min1, float max1, const vec3& xAxis,
+		const vec3& xOffset, const vec3& xVel, float& tAxis, const float tMax);
 	static bool find_MTD(vec3* xAxis, float* taxis, int iAxes, vec3& N, float& t);
 
 	static Colliders colliders_;
-	static Bodies bodies_;
+	static BodyStore bodies_;
+
+	static SweepAndPrune sweepAndPrune_;
+	static AABBTree dynamicTree_, staticTree_;
+	static ColliderPairs pairs_;
+	static std::vector<Contacts> threadContacts_;
+	static Contacts contacts_;
+	static ContactCache contactCache_;
+	static std::vector<std::vector<unsigned>> batches_;
+	static std::vector<ContactManifold> endedContacts_;
+	static CollisionEvents events_;
+	static unsigned stepCount_;
+	static std::vector<float> impacts_;
+	static std::vector<int> islands_;
+	static std::vector<unsigned char> islandFlags_;
+	static Stats stats_;
+	static float accumulator_, alpha_;
+	static std::atomic<bool> treesDirty_;
+	static std::mutex refitLock_;
 };
 
 jeEnd
\ No newline at end of file
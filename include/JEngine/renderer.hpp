@@ -3,11 +3,14 @@
 #include <component.hpp>
 
 struct vec3;
+struct quat;
+struct mat4;
 
 jeBegin
 
 class Light;
 class Shader;
+class RigidBody;
 class Transform;
 
 class Renderer : public Component {
@@ -43,6 +46,13 @@ public:
 	bool picked() const;
 	Transform* get_transform() const { return transform_; }
 
+	// interpolated by physics if the owner has a rigidbody
+	vec3 get_render_position() const;
+	quat get_render_orientation() const;
+
+	// the cached world matrix, or the interpolated one of a body
+	mat4 get_render_matrix() const;
+
 protected:
 
 	virtual void add_to_system() = 0;
@@ -50,13 +60,13 @@ protected:
 	virtual void load(const rapidjson::Value& data) = 0;
 
 	virtual void draw(float dt) = 0;
-	void set_parent_renderer();
+	void find_body();
 
 	unsigned drawMode_;
 	unsigned sfactor_, dfactor_;
 
 	Transform* transform_ = nullptr;
-	Renderer* parent_ = nullptr;
+	RigidBody* body_ = nullptr;
 
 private:
 
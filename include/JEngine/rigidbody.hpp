@@ -2,24 +2,38 @@
 #include <component_builder.hpp>
 #include <component.hpp>
 #include <vec3.hpp>
+#include <quat.hpp>
 
 jeBegin
 
 class Transform;
+
+// moves the local values of the transform, on a root object only
 class RigidBody : public Component {
 
 	jeBaseFriends(RigidBody);
 	friend class PhysicsSystem;
+	friend class BodyStore;
+	friend class Collider2D;
 
 public:
 
 	RigidBody(Object* owner);
 	virtual ~RigidBody();
 
-	void add_impulse(const vec3& force, float dt);
+	void add_impulse(const vec3& force, float dt, bool wake = true);
 	float get_invMass() const;
 
+	void wake_up();
+	bool is_awake() const;
+	vec3 get_displacement() const;
+
+	// state between the last two fixed steps
+	vec3 get_interpolated_position() const;
+	quat get_interpolated_orientation() const;
+
 	bool isStatic = false;
+	bool isBullet = false; // swept bounds in the broad phase
 	Transform* transform;
 
 	float friction;
@@ -34,11 +48,15 @@ protected:
 
 private:
 
-	void process_collision(RigidBody* other, const vec3& N, float t);
-	void process_overlap(RigidBody* other, const vec3& xMTD);
-
 	float mass_;
+
+	// the simulation state lives in the body store of the physics system,
+	// this keeps the displacement only while the body is out of the store
 	vec3 displacement_;
+	int index_ = -1;
+
+	// orientation at the beginning of the last fixed step
+	quat prevOrientation_;
 
 };
 
@@ -0,0 +1,69 @@
+/******************************************************************************/
+/*!
+\file   sat_kernels.hpp
+\author Jeong Juyong
+\par    email: jaykop.jy\@gmail.com
+\date   2026/10/17(yy/mm/dd)
+
+\description
+Contains the definition of SATKernels class
+*/
+/******************************************************************************/
+
+#pragma once
+#include <macros.hpp>
+
+struct vec3;
+
+jeBegin
+
+// projections of a polygon onto many separating axes at once.
+// the widest instruction set the cpu supports is picked once by
+// PhysicsSystem::initialize, before any worker projects, scalar until then
+class SATKernels {
+
+	// Prevent to clone this class
+	SATKernels() = delete;
+	~SATKernels() = delete;
+
+	jePreventClone(SATKernels)
+
+	friend class PhysicsSystem;
+
+public:
+
+	enum class Path { SCALAR, SSE, AVX };
+
+	// axes are read and the intervals written in blocks of this,
+	// so every array must be padded up to a multiple of it
+	static const int LANES = 8;
+
+	static Path get_path();
+	static bool is_supported(Path path);
+
+	// force a path, for the comparisons, unsupported ones are ignored
+	static void set_path(Path path);
+
+	// min and max of the vertices projected onto each axis on xy plane,
+	// the axes are given in separate x and y arrays
+	static void project(const vec3* vertices, int vertexCount,
+		const float* axisX, const float* axisY, int axisCount, float* min, float* max);
+
+private:
+
+	using Kernel = void(*)(const vec3*, int, const float*, const float*, int, float*, float*);
+
+	static void select_path();
+
+	static void project_scalar(const vec3* vertices, int vertexCount,
+		const float* axisX, const float* axisY, int axisCount, float* min, float* max);
+	static void project_sse(const vec3* vertices, int vertexCount,
+		const float* axisX, const float* axisY, int axisCount, float* min, float* max);
+	static void project_avx(const vec3* vertices, int vertexCount,
+		const float* axisX, const float* axisY, int axisCount, float* min, float* max);
+
+	static Kernel kernel_;
+	static Path path_;
+};
+
+jeEnd
@@ -49,6 +49,9 @@ protected:
 	void resume();
 	void pause();
 
+	// the nodes of SystemScheduler, updated as one graph
+	virtual void add_systems();
+
 	Scene* prevScene_ = nullptr;
 	std::string name_, directory_;
 
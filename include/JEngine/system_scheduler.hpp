@@ -0,0 +1,109 @@
+/******************************************************************************/
+/*!
+\file   system_scheduler.hpp
+\author Jeong Juyong
+\par    email: jaykop.jy\@gmail.com
+\date   2026/10/17(yy/mm/dd)
+
+\description
+Contains the definition of SystemScheduler and SystemNode class
+*/
+/******************************************************************************/
+
+#pragma once
+#include <functional>
+#include <job_system.hpp>
+#include <component_archetype.hpp>
+
+jeBegin
+
+// one system of the frame and the component types it touches.
+// the declarations are chained after SystemScheduler::add_system
+class SystemNode {
+
+	jePreventClone(SystemNode)
+
+	friend class SystemScheduler;
+
+public:
+
+	using Update = std::function<void(float)>;
+
+	template <class ComponentType> SystemNode& read();
+	template <class ComponentType> SystemNode& write();
+
+	// for what is not a component, like the collision events
+	SystemNode& after(const char* name);
+
+	// GL and the other thread bound apis
+	SystemNode& on_main_thread();
+
+	// sync point, nothing else runs meanwhile
+	SystemNode& exclusive();
+
+	const char* get_name() const { return name_; }
+
+private:
+
+	SystemNode(const char* name, const Update& update) : name_(name), update_(update) {};
+	~SystemNode() {};
+
+	void add_type(Signature& types, unsigned id);
+	bool conflicts(const SystemNode& other) const;
+	bool is_after(const char* name) const;
+
+	const char* name_;
+	Update update_;
+	Signature reads_, writes_;
+	std::vector<const char*> after_;
+	bool mainThread_ = false, exclusive_ = false;
+
+	// built from the declarations above
+	std::vector<unsigned> dependencies_;
+	unsigned level_ = 0;
+
+	// the last frame, in milliseconds from its start
+	JobCounter done_;
+	float begin_ = 0.f, end_ = 0.f;
+	unsigned thread_ = 0;
+};
+
+// runs the systems of a scene as a graph.
+// a node waits for the earlier nodes it conflicts with,
+// writing a type another one reads or writes, and the rest overlap
+class SystemScheduler {
+
+	// Prevent to clone this class
+	SystemScheduler() = delete;
+	~SystemScheduler() = delete;
+
+	jePreventClone(SystemScheduler)
+
+	friend class Scene;
+	friend class SystemNode;
+
+public:
+
+	// the order of the calls is the order of the conflicting nodes
+	static SystemNode& add_system(const char* name, const SystemNode::Update& update);
+
+	// prints the graph and the timings of the last frame
+	static void dump();
+
+private:
+
+	static void update(float dt);
+	static void clear();
+
+	static void build();
+	static void launch(SystemNode* node, unsigned dependency);
+	static void execute(SystemNode* node);
+
+	static std::vector<SystemNode*> nodes_;
+	static bool built_;
+	static float dt_, frameTime_;
+};
+
+jeEnd
+
+#include <system_scheduler.inl>
@@ -0,0 +1,33 @@
+/******************************************************************************/
+/*!
+\file   system_scheduler.inl
+\author Jeong Juyong
+\par    email: jaykop.jy\@gmail.com
+\date   2026/10/17(yy/mm/dd)
+
+\description
+Contains the template methods of SystemNode class
+*/
+/******************************************************************************/
+
+#pragma once
+#include <system_scheduler.hpp>
+#include <component_manager.hpp>
+
+jeBegin
+
+template <class ComponentType>
+SystemNode& SystemNode::read()
+{
+	add_type(reads_, ComponentManager::get_type_id<ComponentType>());
+	return *this;
+}
+
+template <class ComponentType>
+SystemNode& SystemNode::write()
+{
+	add_type(writes_, ComponentManager::get_type_id<ComponentType>());
+	return *this;
+}
+
+jeEnd
@@ -12,10 +12,11 @@ jeDeclareComponentBuilder(Transform);
 class Transform : public Component {
 
 	jeBaseFriends(Transform);
+	friend class TransformSystem;
 
 public:
 
-	// public members
+	// public members, local to the transform of the parent object
 	quat orientation;
 	vec3 position;
 	vec3 scale;
@@ -35,22 +36,41 @@ public:
 	void set_euler_deg(const vec3& deg);
 	void set_euler_deg(float deg_x, float deg_y, float deg_z);
 
-	// matrix transformation
+	// matrix transformation, of the local values
 	mat4 model_to_world(void) const;
+	static mat4 compose(const vec3& position, const quat& orientation, const vec3& scale);
+
+	// cached by TransformSystem, as of its last update
+	const mat4& get_world_matrix(void) const { return world_; }
+	vec3 get_world_position(void) const;
+	Transform* get_parent(void) const { return parent_; }
 
 protected:
 
-	virtual void add_to_system() {};
-	virtual void remove_from_system() {};
+	virtual void add_to_system();
+	virtual void remove_from_system();
 	virtual void load(const rapidjson::Value& /*data*/) {};
 
 private:
 
 	Transform(Object* owner);
-	virtual ~Transform() {};
+	virtual ~Transform();
 
 	Transform& operator=(const Transform& rhs);
 
+	// same check as the colliders do, the members are written directly
+	bool is_changed(void) const;
+	void cache_local(void);
+
+	mat4 world_;
+	quat cachedOrientation_;
+	vec3 cachedPosition_, cachedScale_;
+	bool dirty_ = true;
+
+	Transform* parent_ = nullptr;
+	int index_ = -1; // in TransformSystem
+	unsigned childCount_ = 0;
+
 };
 
 jeEnd
\ No newline at end of file
@@ -0,0 +1,73 @@
+/******************************************************************************/
+/*!
+\file   transform_system.hpp
+\author Jeong Juyong
+\par    email: jaykop.jy\@gmail.com
+\date   2026/10/17(yy/mm/dd)
+
+\description
+Contains the definition of TransformSystem class
+*/
+/******************************************************************************/
+
+#pragma once
+#include <macros.hpp>
+#include <stack>
+#include <vector>
+
+jeBegin
+
+class Object;
+class Transform;
+
+// caches the world matrix of every transform.
+// the transforms are kept in depth first order of the object hierarchy,
+// so one pass visits a parent before its children and a moved parent
+// passes its dirty flag down to the whole subtree
+class TransformSystem {
+
+	// Prevent to clone this class
+	TransformSystem() = delete;
+	~TransformSystem() = delete;
+
+	jePreventClone(TransformSystem)
+
+	friend class Scene;
+	friend class Object;
+	friend class Transform;
+
+	using Transforms = std::vector<Transform*>;
+
+	// what a paused scene leaves behind
+	struct Hierarchy {
+		Transforms transforms, order;
+		std::vector<int> parents;
+		bool sorted;
+	};
+
+private:
+
+	static void initialize();
+	static void update(float dt);
+	static void close();
+
+	static void pause();
+	static void resume();
+
+	static void add_transform(Transform* transform);
+	static void remove_transform(Transform* transform);
+
+	// the parent of the object has changed
+	static void update_parent(Object* object);
+	static void link(Transform* transform);
+
+	static void sort();
+
+	static Transforms transforms_, order_;
+	static std::vector<int> parents_; // in the order, -1 for the roots
+	static std::vector<char> moved_;
+	static bool sorted_;
+	static std::stack<Hierarchy> hierarchyStack_;
+};
+
+jeEnd
@@ -0,0 +1,342 @@
+/******************************************************************************/
+/*!
+\file   aabb_tree.cpp
+\author Jeong Juyong
+\par    email: jaykop.jy\@gmail.com
+\date   2026/10/17(yy/mm/dd)
+
+\description
+Contains the methods of AABBTree class
+*/
+/******************************************************************************/
+
+#include <aabb_tree.hpp>
+
+jeBegin
+
+int AABBTree::create_proxy(const AABB& aabb, Collider2D* collider)
+{
+	int proxyId = allocate_node();
+
+	// fatten the box
+	Node& node = nodes_[proxyId];
+	node.aabb.min.set(aabb.min.x - margin, aabb.min.y - margin, 0.f);
+	node.aabb.max.set(aabb.max.x + margin, aabb.max.y + margin, 0.f);
+	node.collider = collider;
+	node.height = 0;
+
+	insert_leaf(proxyId);
+	++proxyCount_;
+
+	return proxyId;
+}
+
+void AABBTree::destroy_proxy(int proxyId)
+{
+	remove_leaf(proxyId);
+	free_node(proxyId);
+	--proxyCount_;
+}
+
+bool AABBTree::move_proxy(int proxyId, const AABB& aabb, const vec3& displacement)
+{
+	// still inside of the fat box, nothing to do
+	if (nodes_[proxyId].aabb.contains(aabb))
+		return false;
+
+	remove_leaf(proxyId);
+
+	// extend the box toward the moving direction
+	AABB fat;
+	fat.min.set(aabb.min.x - margin, aabb.min.y - margin, 0.f);
+	fat.max.set(aabb.max.x + margin, aabb.max.y + margin, 0.f);
+
+	vec3 d = displacement * displacementMultiplier;
+	if (d.x < 0.f) fat.min.x += d.x; else fat.max.x += d.x;
+	if (d.y < 0.f) fat.min.y += d.y; else fat.max.y += d.y;
+
+	nodes_[proxyId].aabb = fat;
+
+	insert_leaf(proxyId);
+	return true;
+}
+
+void AABBTree::clear()
+{
+	nodes_.clear();
+	root_ = freeList_ = NULL_NODE;
+	proxyCount_ = 0;
+}
+
+int AABBTree::get_height() const
+{
+	return root_ == NULL_NODE ? 0 : nodes_[root_].height;
+}
+
+int AABBTree::allocate_node()
+{
+	// no free node left, grow the pool
+	if (freeList_ == NULL_NODE)
+	{
+		nodes_.emplace_back();
+		return static_cast<int>(nodes_.size()) - 1;
+	}
+
+	int node = freeList_;
+	freeList_ = nodes_[node].next;
+	nodes_[node] = Node();
+	return node;
+}
+
+void AABBTree::free_node(int node)
+{
+	nodes_[node].next = freeList_;
+	nodes_[node].height = -1;
+	nodes_[node].collider = nullptr;
+	freeList_ = node;
+}
+
+void AABBTree::insert_leaf(int leaf)
+{
+	if (root_ == NULL_NODE)
+	{
+		root_ = leaf;
+		nodes_[root_].parent = NULL_NODE;
+		return;
+	}
+
+	// find the best sibling by the surface area heuristic
+	AABB leafAABB = nodes_[leaf].aabb;
+	int index = root_;
+	while (!nodes_[index].is_leaf())
+	{
+		int child1 = nodes_[index].child1;
+		int child2 = nodes_[index].child2;
+
+		float area = nodes_[index].aabb.perimeter();
+		float combinedArea = AABB::combine(nodes_[index].aabb, leafAABB).perimeter();
+
+		// cost of creating a new parent for this node and the new leaf
+		float cost = 2.f * combinedArea;
+
+		// minimum cost of pushing the leaf further down the tree
+		float inheritanceCost = 2.f * (combinedArea - area);
+
+		float cost1 = AABB::combine(leafAABB, nodes_[child1].aabb).perimeter() + inheritanceCost;
+		if (!nodes_[child1].is_leaf())
+			cost1 -= nodes_[child1].aabb.perimeter();
+
+		float cost2 = AABB::combine(leafAABB, nodes_[child2].aabb).perimeter() + inheritanceCost;
+		if (!nodes_[child2].is_leaf())
+			cost2 -= nodes_[child2].aabb.perimeter();
+
+		if (cost < cost1 && cost < cost2)
+			break;
+
+		index = cost1 < cost2 ? child1 : child2;
+	}
+
+	int sibling = index;
+
+	// create a new parent
+	int oldParent = nodes_[sibling].parent;
+	int newParent = allocate_node();
+	nodes_[newParent].parent = oldParent;
+	nodes_[newParent].aabb = AABB::combine(leafAABB, nodes_[sibling].aabb);
+	nodes_[newParent].height = nodes_[sibling].height + 1;
+	nodes_[newParent].child1 = sibling;
+	nodes_[newParent].child2 = leaf;
+	nodes_[sibling].parent = newParent;
+	nodes_[leaf].parent = newParent;
+
+	if (oldParent != NULL_NODE)
+	{
+		if (nodes_[oldParent].child1 == sibling)
+			nodes_[oldParent].child1 = newParent;
+		else
+			nodes_[oldParent].child2 = newParent;
+	}
+	else
+		root_ = newParent;
+
+	// walk back up the tree fixing heights and boxes
+	index = nodes_[leaf].parent;
+	while (index != NULL_NODE)
+	{
+		index = balance(index);
+
+		int child1 = nodes_[index].child1;
+		int child2 = nodes_[index].child2;
+
+		nodes_[index].height = 1 + (nodes_[child1].height > nodes_[child2].height
+			? nodes_[child1].height : nodes_[child2].height);
+		nodes_[index].aabb = AABB::combine(nodes_[child1].aabb, nodes_[child2].aabb);
+
+		index = nodes_[index].parent;
+	}
+}
+
+void AABBTree::remove_leaf(int leaf)
+{
+	if (leaf == root_)
+	{
+		root_ = NULL_NODE;
+		return;
+	}
+
+	int parent = nodes_[leaf].parent;
+	int grandParent = nodes_[parent].parent;
+	int sibling = nodes_[parent].child1 == leaf ? nodes_[parent].child2 : nodes_[parent].child1;
+
+	if (grandParent != NULL_NODE)
+	{
+		// destroy the parent and connect the sibling to the grand parent
+		if (nodes_[grandParent].child1 == parent)
+			nodes_[grandParent].child1 = sibling;
+		else
+			nodes_[grandParent].child2 = sibling;
+
+		nodes_[sibling].parent = grandParent;
+		free_node(parent);
+
+		int index = grandParent;
+		while (index != NULL_NODE)
+		{
+			index = balance(index);
+
+			int child1 = nodes_[index].child1;
+			int child2 = nodes_[index].child2;
+
+			nodes_[index].aabb = AABB::combine(nodes_[child1].aabb, nodes_[child2].aabb);
+			nodes_[index].height = 1 + (nodes_[child1].height > nodes_[child2].height
+				? nodes_[child1].height : nodes_[child2].height);
+
+			index = nodes_[index].parent;
+		}
+	}
+	else
+	{
+		root_ = sibling;
+		nodes_[sibling].parent = NULL_NODE;
+		free_node(parent);
+	}
+}
+
+// rotate the subtree if it is imbalanced, returns the new subtree root
+int AABBTree::balance(int iA)
+{
+	Node* A = &nodes_[iA];
+	if (A->is_leaf() || A->height < 2)
+		return iA;
+
+	int iB = A->child1;
+	int iC = A->child2;
+	Node* B = &nodes_[iB];
+	Node* C = &nodes_[iC];
+
+	int diff = C->height - B->height;
+
+	// rotate C up
+	if (diff > 1)
+	{
+		int iF = C->child1;
+		int iG = C->child2;
+		Node* F = &nodes_[iF];
+		Node* G = &nodes_[iG];
+
+		// swap A and C
+		C->child1 = iA;
+		C->parent = A->parent;
+		A->parent = iC;
+
+		if (C->parent != NULL_NODE)
+		{
+			if (nodes_[C->parent].child1 == iA)
+				nodes_[C->parent].child1 = iC;
+			else
+				nodes_[C->parent].child2 = iC;
+		}
+		else
+			root_ = iC;
+
+		// rotate the higher grand child up
+		if (F->height > G->height)
+		{
+			C->child2 = iF;
+			A->child2 = iG;
+			G->parent = iA;
+			A->aabb = AABB::combine(B->aabb, G->aabb);
+			C->aabb = AABB::combine(A->aabb, F->aabb);
+
+			A->height = 1 + (B->height > G->height ? B->height : G->height);
+			C->height = 1 + (A->height > F->height ? A->height : F->height);
+		}
+		else
+		{
+			C->child2 = iG;
+			A->child2 = iF;
+			F->parent = iA;
+			A->aabb = AABB::combine(B->aabb, F->aabb);
+			C->aabb = AABB::combine(A->aabb, G->aabb);
+
+			A->height = 1 + (B->height > F->height ? B->height : F->height);
+			C->height = 1 + (A->height > G->height ? A->height : G->height);
+		}
+
+		return iC;
+	}
+
+	// rotate B up
+	if (diff < -1)
+	{
+		int iD = B->child1;
+		int iE = B->child2;
+		Node* D = &nodes_[iD];
+		Node* E = &nodes_[iE];
+
+		// swap A and B
+		B->child1 = iA;
+		B->parent = A->parent;
+		A->parent = iB;
+
+		if (B->parent != NULL_NODE)
+		{
+			if (nodes_[B->parent].child1 == iA)
+				nodes_[B->parent].child1 = iB;
+			else
+				nodes_[B->parent].child2 = iB;
+		}
+		else
+			root_ = iB;
+
+		// rotate the higher grand child up
+		if (D->height > E->height)
+		{
+			B->child2 = iD;
+			A->child1 = iE;
+			E->parent = iA;
+			A->aabb = AABB::combine(C->aabb, E->aabb);
+			B->aabb = AABB::combine(A->aabb, D->aabb);
+
+			A->height = 1 + (C->height > E->height ? C->height : E->height);
+			B->height = 1 + (A->height > D->height ? A->height : D->height);
+		}
+		else
+		{
+			B->child2 = iE;
+			A->child1 = iD;
+			D->parent = iA;
+			A->aabb = AABB::combine(C->aabb, D->aabb);
+			B->aabb = AABB::combine(A->aabb, E->aabb);
+
+			A->height = 1 + (C->height > D->height ? C->height : D->height);
+			B->height = 1 + (A->height > E->height ? A->height : E->height);
+		}
+
+		return iB;
+	}
+
+	return iA;
+}
+
+jeEnd
@@ -6,6 +6,7 @@
 #include <scene_manager.hpp>
 #include <asset_manager.hpp>
 #include <input_handler.hpp>
+#include <job_system.hpp>
 #include <SDL_image.h>
 #include <graphic_system.hpp>
 
@@ -67,6 +68,9 @@ bool Application::initialize()
 
 	Random::seed();
 
+	// workers are ready before the assets start loading
+	JobSystem::initialize();
+
 	// Check right init
 	if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_TIMER) != 0) {
 		// Print error message
@@ -175,6 +179,7 @@ void Application::close()
 	AssetManager::unload_assets();
 	GraphicSystem::close_graphics();
 	JsonParser::close();
+	JobSystem::close();
 }
 
 void Application::quit()
@@ -12,11 +12,13 @@ Contains the methods of BehaviorSystem class
 #include <behavior_system.hpp>
 #include <behavior.hpp>
 #include <object.hpp>
+#include <collider_2d.hpp>
 
 jeBegin
 
 std::stack<BehaviorSystem::Behaviors> BehaviorSystem::componentStack_;
 BehaviorSystem::Behaviors BehaviorSystem::behaviors_;
+std::unordered_multimap<Object*, Behavior*> BehaviorSystem::listeners_;
 
 void BehaviorSystem::add_behavior(Behavior* behavior)
 {
@@ -25,6 +27,17 @@ void BehaviorSystem::add_behavior(Behavior* behavior)
 
 void BehaviorSystem::remove_behavior(Behavior* behavior)
 {
+	// removed in the middle of the collision dispatch
+	auto range = listeners_.equal_range(behavior->get_owner());
+	for (auto it = range.first; it != range.second; ++it)
+	{
+		if (it->second == behavior)
+		{
+			listeners_.erase(it);
+			break;
+		}
+	}
+
 	for (auto it = behaviors_.begin(); it != behaviors_.end(); ++it) {
 		if (*it == behavior) {
 			behaviors_.erase(it);
@@ -47,6 +60,77 @@ void BehaviorSystem::update(float dt)
 		behaviors_[i]->update(dt);
 }
 
+void BehaviorSystem::dispatch_collisions(const CollisionEvents& events)
+{
+	if (events.empty() || behaviors_.empty())
+		return;
+
+	// behaviors of each object, built once for the whole batch
+	for (const auto& b : behaviors_)
+		listeners_.emplace(b->get_owner(), b);
+
+	Behaviors targets;
+	auto send = [&](const CollisionEvent& e) {
+		Object* owner = e.collider->get_owner();
+
+		targets.clear();
+		auto range = listeners_.equal_range(owner);
+		for (auto it = range.first; it != range.second; ++it)
+			targets.push_back(it->second);
+
+		for (const auto& b : targets)
+		{
+			// removed by one of the callbacks before
+			if (!is_listening(owner, b))
+				continue;
+
+			switch (e.type)
+			{
+			case CollisionEvent::Type::BEGIN:
+				b->on_collision_begin(e);
+				break;
+			case CollisionEvent::Type::STAY:
+				b->on_collision_stay(e);
+				break;
+			case CollisionEvent::Type::END:
+				b->on_collision_end(e);
+				break;
+			}
+		}
+	};
+
+	// removed colliders have their events emptied by the physics system
+	for (unsigned i = 0; i < events.size(); ++i)
+	{
+		CollisionEvent e = events[i];
+		if (!e.collider || !e.other)
+			continue;
+
+		send(e);
+
+		// the same contact seen from the other side
+		e = events[i];
+		if (!e.collider || !e.other)
+			continue;
+
+		send({ e.type, e.other, e.collider, -e.normal });
+	}
+
+	listeners_.clear();
+}
+
+bool BehaviorSystem::is_listening(Object* owner, Behavior* behavior)
+{
+	auto range = listeners_.equal_range(owner);
+	for (auto it = range.first; it != range.second; ++it)
+	{
+		if (it->second == behavior)
+			return true;
+	}
+
+	return false;
+}
+
 void BehaviorSystem::close()
 {
 	for (const auto& b : behaviors_)
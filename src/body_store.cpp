@@ -0,0 +1,88 @@
+/******************************************************************************/
+/*!
+\file   body_store.cpp
+\author Jeong Juyong
+\par    email: jaykop.jy\@gmail.com
+\date   2026/10/17(yy/mm/dd)
+
+\description
+Contains the methods of BodyStore class
+*/
+/******************************************************************************/
+
+#include <body_store.hpp>
+#include <rigidbody.hpp>
+#include <collider_2d.hpp>
+#include <transform.hpp>
+
+jeBegin
+
+int BodyStore::add(RigidBody* body)
+{
+	int index = static_cast<int>(owner.size());
+
+	// the displacement given before the registration is carried over
+	owner.emplace_back(body);
+	collider.emplace_back(nullptr);
+	position.emplace_back(body->transform->position);
+	prevPosition.emplace_back(body->transform->position);
+	displacement.emplace_back(body->isStatic ? vec3::zero : body->displacement_);
+	correction.emplace_back(vec3::zero);
+	invMass.emplace_back(body->get_invMass());
+	flags.emplace_back(static_cast<unsigned char>(
+		(body->isStatic ? STATIC : 0) | (body->isBullet ? BULLET : 0)));
+	restSteps.emplace_back(0);
+	colorMask.emplace_back(0);
+
+	return index;
+}
+
+void BodyStore::remove(int index)
+{
+	// move the last body into the hole
+	int last = static_cast<int>(owner.size()) - 1;
+	if (index != last)
+	{
+		owner[index] = owner[last];
+		collider[index] = collider[last];
+		position[index] = position[last];
+		prevPosition[index] = prevPosition[last];
+		displacement[index] = displacement[last];
+		correction[index] = correction[last];
+		invMass[index] = invMass[last];
+		flags[index] = flags[last];
+		restSteps[index] = restSteps[last];
+		colorMask[index] = colorMask[last];
+
+		owner[index]->index_ = index;
+		if (collider[index])
+			collider[index]->body_ = index;
+	}
+
+	owner.pop_back();
+	collider.pop_back();
+	position.pop_back();
+	prevPosition.pop_back();
+	displacement.pop_back();
+	correction.pop_back();
+	invMass.pop_back();
+	flags.pop_back();
+	restSteps.pop_back();
+	colorMask.pop_back();
+}
+
+void BodyStore::clear()
+{
+	owner.clear();
+	collider.clear();
+	position.clear();
+	prevPosition.clear();
+	displacement.clear();
+	correction.clear();
+	invMass.clear();
+	flags.clear();
+	restSteps.clear();
+	colorMask.clear();
+}
+
+jeEnd
@@ -0,0 +1,128 @@
+/******************************************************************************/
+/*!
+\file   broad_phase.cpp
+\author Jeong Juyong
+\par    email: jaykop.jy\@gmail.com
+\date   2026/10/17(yy/mm/dd)
+
+\description
+Contains the methods of SweepAndPrune class
+*/
+/******************************************************************************/
+
+#include <algorithm>
+#include <broad_phase.hpp>
+#include <collider_2d.hpp>
+
+jeBegin
+
+void SweepAndPrune::add(Collider2D* collider)
+{
+	resort_ = true;
+
+	// removed and added again before the sweep, the old entry still stands
+	auto found = std::find(removed_.begin(), removed_.end(), collider);
+	if (found != removed_.end()) {
+		removed_.erase(found);
+		return;
+	}
+
+	axis_.emplace_back(collider);
+}
+
+void SweepAndPrune::remove(Collider2D* collider)
+{
+	// dropped together before the next sweep, one pass for any number of them
+	removed_.emplace_back(collider);
+}
+
+void SweepAndPrune::clear()
+{
+	axis_.clear();
+	active_.clear();
+	removed_.clear();
+	resort_ = false;
+}
+
+void SweepAndPrune::drop_removed()
+{
+	if (removed_.empty())
+		return;
+
+	// the removed colliders may be gone, only their addresses are compared
+	std::sort(removed_.begin(), removed_.end());
+	axis_.erase(std::remove_if(axis_.begin(), axis_.end(),
+		[this](Collider2D* c) { return std::binary_search(removed_.begin(), removed_.end(), c); }),
+		axis_.end());
+
+	removed_.clear();
+}
+
+void SweepAndPrune::sort_axis()
+{
+	// new colliders are appended at the end unsorted
+	if (resort_)
+	{
+		std::sort(axis_.begin(), axis_.end(),
+			[](const Collider2D* a, const Collider2D* b) {
+				return a->bounds_.min.x < b->bounds_.min.x;
+			});
+
+		resort_ = false;
+		return;
+	}
+
+	// the order barely changes frame to frame,
+	// so insertion sort is almost linear here
+	int size = static_cast<int>(axis_.size());
+	for (int i = 1; i < size; ++i)
+	{
+		Collider2D* key = axis_[i];
+		float minX = key->bounds_.min.x;
+
+		int j = i - 1;
+		while (j >= 0 && axis_[j]->bounds_.min.x > minX)
+		{
+			axis_[j + 1] = axis_[j];
+			--j;
+		}
+
+		axis_[j + 1] = key;
+	}
+}
+
+void SweepAndPrune::find_pairs(ColliderPairs& pairs)
+{
+	pairs.clear();
+	active_.clear();
+
+	drop_removed();
+	sort_axis();
+
+	for (const auto& collider : axis_)
+	{
+		const AABB& bounds = collider->bounds_;
+
+		// drop the colliders whose interval ended before this one starts
+		unsigned alive = 0;
+		for (const auto& other : active_)
+		{
+			if (other->bounds_.max.x >= bounds.min.x)
+				active_[alive++] = other;
+		}
+		active_.resize(alive);
+
+		// x intervals overlap with every active one, check y
+		for (const auto& other : active_)
+		{
+			if (other->bounds_.min.y <= bounds.max.y
+				&& bounds.min.y <= other->bounds_.max.y
+				&& other->can_collide(collider))
+				pairs.push_back({ other, collider });
+		}
+
+		active_.emplace_back(collider);
+	}
+}
+
+jeEnd
@@ -2,6 +2,8 @@
 #include <physics_system.hpp>
 #include <transform.hpp>
 #include <object.hpp>
+#include <debug_tools.hpp>
+#include <cmath>
 
 jeBegin
 
@@ -9,37 +11,250 @@ jeDefineComponentBuilder(Collider2D);
 
 Collider2D::Collider2D(Object* owner) : Component(owner) {}
 
-Collider2D::~Collider2D() {}
+Collider2D::~Collider2D()
+{
+	remove_from_system();
+}
 
 void Collider2D::add_to_system()
 {
+	DEBUG_ASSERT(!get_owner()->has_parent(), "Collider2D on a child object!");
 	transform = get_owner()->get_component<Transform>();
-	init_vertices();
+
+	// link to the body if it is registered already,
+	// otherwise the body links this on its registration
+	RigidBody* body = get_owner()->has_component<RigidBody>()
+		? get_owner()->get_component<RigidBody>() : nullptr;
+	if (body && body->index_ >= 0)
+	{
+		body_ = body->index_;
+		static_ = body->isStatic;
+		PhysicsSystem::bodies_.collider[body_] = this;
+	}
+
+	dirty_ = true;
+	update_transform();
 	PhysicsSystem::add_collider(this);
 }
 
 void Collider2D::remove_from_system()
 {
-	vertices_.clear();
+	if (body_ >= 0)
+	{
+		PhysicsSystem::bodies_.collider[body_] = nullptr;
+		body_ = -1;
+		static_ = true;
+	}
+
+	vertexCount_ = 0;
+	radius_ = 0.f;
+	PhysicsSystem::remove_collider(this);
+}
+
+RigidBody* Collider2D::get_body() const
+{
+	return body_ >= 0 ? PhysicsSystem::bodies_.owner[body_] : nullptr;
 }
 
 void Collider2D::init_vertices()
 {
-	vertices_.clear();
+	const vec3& scale = transform->scale;
+
+	// circle has no vertex, scale.x works as radius
+	if (is_circle())
+	{
+		radius_ = scale.x;
+		vertexCount_ = 0;
+		return;
+	}
+
+	// box in local space, scale works as half extents
+	radius_ = 0.f;
+
+	vertices_[0].set(-scale.x, scale.y, 0.f);
+	vertices_[1].set(scale.x, scale.y, 0.f);
+	vertices_[2].set(scale.x, -scale.y, 0.f);
+	vertices_[3].set(-scale.x, -scale.y, 0.f);
+	vertexCount_ = 4;
+}
+
+bool Collider2D::update_transform()
+{
+	if (!dirty_
+		&& position_ == transform->position
+		&& scale_ == transform->scale
+		&& orientation_ == transform->orientation)
+		return false;
+
+	if (dirty_ || scale_ != transform->scale)
+	{
+		scale_ = transform->scale;
+		init_vertices();
+	}
+
+	if (dirty_ || orientation_ != transform->orientation)
+	{
+		orientation_ = transform->orientation;
+		rotation_ = orientation_.to_mat3();
+	}
+
+	position_ = transform->position;
+	dirty_ = false;
+
+	update_bounds();
+	return true;
+}
+
+void Collider2D::update_bounds()
+{
+	if (is_circle())
+	{
+		bounds_.min.set(position_.x - radius_, position_.y - radius_, 0.f);
+		bounds_.max.set(position_.x + radius_, position_.y + radius_, 0.f);
+		return;
+	}
+
+	if (!vertexCount_)
+	{
+		bounds_.min = bounds_.max = position_;
+		return;
+	}
+
+	bounds_.min = bounds_.max = rotation_ * vertices_[0] + position_;
+	for (int i = 1; i < vertexCount_; ++i)
+	{
+		vec3 v = rotation_ * vertices_[i] + position_;
+
+		if (v.x < bounds_.min.x) bounds_.min.x = v.x;
+		if (v.y < bounds_.min.y) bounds_.min.y = v.y;
+		if (v.x > bounds_.max.x) bounds_.max.x = v.x;
+		if (v.y > bounds_.max.y) bounds_.max.y = v.y;
+	}
+}
+
+// union of the start and end bounds of this step
+void Collider2D::sweep_bounds(const vec3& displacement)
+{
+	update_bounds();
+
+	if (displacement.x < 0.f) bounds_.min.x += displacement.x; else bounds_.max.x += displacement.x;
+	if (displacement.y < 0.f) bounds_.min.y += displacement.y; else bounds_.max.y += displacement.y;
+	swept_ = true;
+}
+
+void Collider2D::get_normals(vec3* normals) const
+{
+	vec3 centroid;
+	for (int i = 0; i < vertexCount_; ++i)
+		centroid += vertices_[i];
+	centroid /= static_cast<float>(vertexCount_);
+
+	// flip the ones facing the centroid, so that either winding works
+	for (int i = 0; i < vertexCount_; ++i)
+	{
+		const vec3& v = vertices_[i];
+		vec3 E = vertices_[(i + 1) % vertexCount_] - v;
+		normals[i] = vec3(-E.y, E.x, 0.f).normalized();
+
+		if (normals[i].dot(v - centroid) < 0.f)
+			normals[i] = -normals[i];
+	}
+}
+
+bool Collider2D::test_point(const vec3& point) const
+{
+	if (is_circle())
+	{
+		vec3 d = point - position_;
+		return d.x * d.x + d.y * d.y <= radius_ * radius_;
+	}
+
+	if (vertexCount_ < 3)
+		return false;
+
+	vec3 normals[MAX_VERTICES];
+	get_normals(normals);
+
+	vec3 local = rotation_.transposed() * (point - position_);
+	local.z = 0.f;
+
+	for (int i = 0; i < vertexCount_; ++i)
+	{
+		if (normals[i].dot(local - vertices_[i]) > 0.f)
+			return false;
+	}
+
+	return true;
+}
+
+// rays starting inside of the shape do not hit it
+bool Collider2D::raycast(const vec3& from, const vec3& to, float maxFraction, float& fraction, vec3& normal) const
+{
+	if (is_circle())
+	{
+		vec3 m = from - position_, d = to - from;
+		m.z = d.z = 0.f;
+
+		float c = m.dot(m) - radius_ * radius_;
+		float b = m.dot(d);
+		float dd = d.dot(d);
+		float discriminant = b * b - dd * c;
+
+		if (c < 0.f || dd < 0.000001f || discriminant < 0.f)
+			return false;
+
+		float t = (-b - sqrtf(discriminant)) / dd;
+		if (t < 0.f || t > maxFraction)
+			return false;
+
+		fraction = t;
+		normal = (m + d * t).normalized();
+		return true;
+	}
+
+	if (vertexCount_ < 2)
+		return false;
+
+	vec3 normals[MAX_VERTICES];
+	get_normals(normals);
+
+	// clip the segment by every edge in the local space
+	mat3 transposed = rotation_.transposed();
+	vec3 p1 = transposed * (from - position_);
+	vec3 d = transposed * (to - from);
+	p1.z = d.z = 0.f;
+
+	float lower = 0.f, upper = maxFraction;
+	int index = -1;
+
+	for (int i = 0; i < vertexCount_; ++i)
+	{
+		float numerator = normals[i].dot(vertices_[i] - p1);
+		float denominator = normals[i].dot(d);
+
+		if (denominator == 0.f)
+		{
+			if (numerator < 0.f)
+				return false;
+		}
+		else if (denominator < 0.f && numerator < lower * denominator)
+		{
+			lower = numerator / denominator;
+			index = i;
+		}
+		else if (denominator > 0.f && numerator < upper * denominator)
+			upper = numerator / denominator;
 
-	vec3 scale = transform->scale;
-	vec3 pos = transform->position;
-	float rad = transform->rotation_euler_rad().z;
+		if (upper < lower)
+			return false;
+	}
 
-	vec3 lt(pos.x - scale.x, pos.y + scale.y, 0.f);
-	vec3 rt(pos.x + scale.x, pos.y + scale.y, 0.f);
-	vec3 rb(pos.x + scale.x, pos.y - scale.y, 0.f);
-	vec3 lb(pos.x - scale.x, pos.y - scale.y, 0.f);
+	if (index < 0)
+		return false;
 
-	vertices_.emplace_back(vec3::rotate(lt, pos, rad));
-	vertices_.emplace_back(vec3::rotate(rt, pos, rad));
-	vertices_.emplace_back(vec3::rotate(rb, pos, rad));
-	vertices_.emplace_back(vec3::rotate(lb, pos, rad));
+	fraction = lower;
+	normal = rotation_ * normals[index];
+	return true;
 }
 
 jeEnd
\ No newline at end of file
@@ -0,0 +1,167 @@
+/******************************************************************************/
+/*!
+\file   command_buffer.cpp
+\author Jeong Juyong
+\par    email: jaykop.jy\@gmail.com
+\date   2026/10/17(yy/mm/dd)
+
+\description
+Contains the methods of CommandBuffer class
+*/
+/******************************************************************************/
+
+#include <cstring>
+#include <object.hpp>
+#include <command_buffer.hpp>
+#include <object_manager.hpp>
+#include <component_manager.hpp>
+
+jeBegin
+
+std::vector<CommandBuffer*> CommandBuffer::buffers_;
+std::vector<Object*> CommandBuffer::created_;
+std::mutex CommandBuffer::lock_;
+
+CommandBuffer& CommandBuffer::get()
+{
+	thread_local CommandBuffer* buffer = nullptr;
+
+	// the first record of a thread, the buffer lives as long as the program
+	if (!buffer) {
+		buffer = new CommandBuffer;
+		std::lock_guard<std::mutex> guard(lock_);
+		buffers_.emplace_back(buffer);
+	}
+
+	return *buffer;
+}
+
+void CommandBuffer::create_object(const char* name, const Setup& setup)
+{
+	int offset = -1;
+	if (name && *name) {
+		offset = static_cast<int>(recording_.names.size());
+		recording_.names.insert(recording_.names.end(), name, name + strlen(name) + 1);
+	}
+
+	Command command;
+	command.type = CommandType::CREATE;
+	command.typeName = nullptr;
+	command.name = offset;
+	command.setup = static_cast<unsigned>(recording_.setups.size());
+	recording_.commands.emplace_back(command);
+	recording_.setups.emplace_back(setup);
+}
+
+void CommandBuffer::remove_object(ObjectHandle handle)
+{
+	record(CommandType::REMOVE, handle, nullptr);
+}
+
+void CommandBuffer::add_component(ObjectHandle handle, const char* componentName)
+{
+	record(CommandType::ADD_COMPONENT, handle, ComponentManager::key_to_type(componentName));
+}
+
+void CommandBuffer::remove_component(ObjectHandle handle, const char* componentName)
+{
+	record(CommandType::REMOVE_COMPONENT, handle, ComponentManager::key_to_type(componentName));
+}
+
+void CommandBuffer::record(CommandType type, ObjectHandle handle, const char* typeName)
+{
+	Command command;
+	command.type = type;
+	command.handle = handle;
+	command.typeName = typeName;
+	command.name = -1;
+	command.setup = 0;
+	recording_.commands.emplace_back(command);
+}
+
+void CommandBuffer::Record::clear()
+{
+	commands.clear();
+	setups.clear();
+	names.clear();
+}
+
+void CommandBuffer::play_back()
+{
+	// swapping keeps the capacity of both sides.
+	// the other threads are idle at the sync point,
+	// the lock only guards the buffers against a late first record
+	{
+		std::lock_guard<std::mutex> guard(lock_);
+		for (auto& buffer : buffers_)
+			std::swap(buffer->recording_, buffer->playing_);
+	}
+
+	// new objects first, so they are set up before anything joins the systems
+	for (auto& buffer : buffers_) {
+		const Record& record = buffer->playing_;
+		for (const auto& command : record.commands) {
+
+			if (command.type != CommandType::CREATE)
+				continue;
+
+			const char* name = command.name < 0 ? nullptr : &record.names[command.name];
+			Object* object = ObjectManager::create_object(name);
+			if (!object)
+				continue;
+
+			if (record.setups[command.setup])
+				record.setups[command.setup](object);
+
+			created_.emplace_back(object);
+		}
+	}
+
+	// the handles were taken from the objects alive at the recording
+	for (auto& buffer : buffers_) {
+		for (const auto& command : buffer->playing_.commands) {
+
+			if (command.type != CommandType::ADD_COMPONENT
+				&& command.type != CommandType::REMOVE_COMPONENT)
+				continue;
+
+			Object* object = ObjectManager::get_object(command.handle);
+			if (!object)
+				continue;
+
+			if (command.type == CommandType::ADD_COMPONENT)
+				object->attach_live_component(command.typeName);
+			else {
+				unsigned typeId = ComponentManager::get_type_id(command.typeName);
+				if (object->find_component(typeId))
+					object->detach_component(typeId);
+			}
+		}
+	}
+
+	for (auto& object : created_)
+		object->register_components();
+
+	created_.clear();
+
+	// a removed object may have been touched above, so it goes last
+	for (auto& buffer : buffers_) {
+		for (const auto& command : buffer->playing_.commands) {
+
+			if (command.type == CommandType::REMOVE
+				&& ObjectManager::has_object(command.handle))
+				ObjectManager::remove_object(command.handle);
+		}
+
+		buffer->playing_.clear();
+	}
+}
+
+void CommandBuffer::clear()
+{
+	std::lock_guard<std::mutex> guard(lock_);
+	for (auto& buffer : buffers_)
+		buffer->recording_.clear();
+}
+
+jeEnd
@@ -0,0 +1,196 @@
+/******************************************************************************/
+/*!
+\file   component_archetype.cpp
+\author Jeong Juyong
+\par    email: jaykop.jy\@gmail.com
+\date   2026/10/17(yy/mm/dd)
+
+\description
+Contains the methods of ComponentArchetype and ArchetypeStorage class
+*/
+/******************************************************************************/
+
+#include <algorithm>
+#include <component_archetype.hpp>
+#include <component_query.hpp>
+#include <object.hpp>
+
+jeBegin
+
+ComponentArchetype::ComponentArchetype(const Signature& signature)
+	: signature_(signature)
+{
+	if (!signature_.empty())
+		columnOf_.assign(signature_.back() + 1, -1);
+
+	for (unsigned i = 0; i < signature_.size(); ++i)
+		columnOf_[signature_[i]] = static_cast<int>(i);
+}
+
+ComponentArchetype::~ComponentArchetype()
+{
+	for (auto& chunk : chunks_)
+		delete chunk;
+
+	chunks_.clear();
+}
+
+bool ComponentArchetype::has_all(const Signature& types) const
+{
+	for (const auto& type : types)
+	{
+		if (get_column(type) < 0)
+			return false;
+	}
+
+	return true;
+}
+
+unsigned ComponentArchetype::add(Object* object)
+{
+	unsigned row = size_++;
+	unsigned index = row / CHUNK_SIZE;
+
+	if (index == chunks_.size())
+	{
+		Chunk* chunk = new Chunk;
+		chunk->components.assign(signature_.size() * CHUNK_SIZE, nullptr);
+		chunks_.push_back(chunk);
+	}
+
+	Chunk& chunk = *chunks_[index];
+	chunk.objects[chunk.count++] = object;
+	return row;
+}
+
+Object* ComponentArchetype::remove(unsigned row)
+{
+	unsigned last = --size_;
+	Chunk& lastChunk = *chunks_[last / CHUNK_SIZE];
+	--lastChunk.count;
+
+	if (row == last)
+		return nullptr;
+
+	// move the last object into the hole
+	unsigned lastIndex = last % CHUNK_SIZE;
+	Chunk& chunk = *chunks_[row / CHUNK_SIZE];
+	unsigned index = row % CHUNK_SIZE;
+
+	chunk.objects[index] = lastChunk.objects[lastIndex];
+	for (unsigned c = 0; c < signature_.size(); ++c)
+		chunk.components[c * CHUNK_SIZE + index] = lastChunk.components[c * CHUNK_SIZE + lastIndex];
+
+	return chunk.objects[index];
+}
+
+ArchetypeStorage::~ArchetypeStorage()
+{
+	for (auto& query : queries_)
+		delete query.second;
+
+	for (auto& archetype : archetypes_)
+		delete archetype;
+
+	queries_.clear();
+	signatures_.clear();
+	archetypes_.clear();
+}
+
+ComponentArchetype* ArchetypeStorage::find_or_create(const Signature& signature)
+{
+	auto found = signatures_.find(signature);
+	if (found != signatures_.end())
+		return found->second;
+
+	ComponentArchetype* archetype = new ComponentArchetype(signature);
+	archetypes_.push_back(archetype);
+	signatures_.insert({ signature, archetype });
+
+	// the only moment a query can get a new match
+	for (auto& query : queries_)
+		query.second->match(archetype);
+
+	return archetype;
+}
+
+ComponentQuery* ArchetypeStorage::get_query(const unsigned* ids, unsigned count)
+{
+	std::vector<unsigned> key(ids, ids + count);
+	auto found = queries_.find(key);
+	if (found != queries_.end())
+		return found->second;
+
+	ComponentQuery* query = new ComponentQuery(ids, count);
+	for (const auto& archetype : archetypes_)
+		query->match(archetype);
+
+	queries_.insert({ key, query });
+	return query;
+}
+
+void ArchetypeStorage::add(Object* object)
+{
+	object->archetype_ = find_or_create(Signature());
+	object->row_ = object->archetype_->add(object);
+}
+
+void ArchetypeStorage::remove(Object* object)
+{
+	Object* moved = object->archetype_->remove(object->row_);
+	if (moved)
+		moved->row_ = object->row_;
+
+	object->archetype_ = nullptr;
+}
+
+void ArchetypeStorage::move(Object* object, ComponentArchetype* to)
+{
+	ComponentArchetype* from = object->archetype_;
+	unsigned row = to->add(object);
+
+	// carry the components both sets have
+	for (unsigned c = 0; c < from->signature_.size(); ++c)
+	{
+		int column = to->get_column(from->signature_[c]);
+		if (column >= 0)
+			to->at(row, column) = from->at(object->row_, c);
+	}
+
+	remove(object);
+	object->archetype_ = to;
+	object->row_ = row;
+}
+
+void ArchetypeStorage::add_component(Object* object, unsigned typeId, Component* component)
+{
+	Signature signature = object->archetype_->signature_;
+	signature.insert(std::lower_bound(signature.begin(), signature.end(), typeId), typeId);
+
+	ComponentArchetype* to = find_or_create(signature);
+	move(object, to);
+	to->at(object->row_, to->get_column(typeId)) = component;
+
+	if (object->lookup_.size() <= typeId)
+		object->lookup_.resize(typeId + 1, nullptr);
+	object->lookup_[typeId] = component;
+}
+
+Component* ArchetypeStorage::remove_component(Object* object, unsigned typeId)
+{
+	ComponentArchetype* from = object->archetype_;
+	int column = from->get_column(typeId);
+	if (column < 0)
+		return nullptr;
+
+	Component* component = from->at(object->row_, column);
+	object->lookup_[typeId] = nullptr;
+
+	Signature signature = from->signature_;
+	signature.erase(signature.begin() + column);
+	move(object, find_or_create(signature));
+
+	return component;
+}
+
+jeEnd
@@ -18,9 +18,11 @@ jeBegin
 
 ComponentManager::BuilderMap ComponentManager::builderMap_;
 ComponentManager::Directory ComponentManager::keys_, ComponentManager::types_;
+ComponentManager::TypeIds ComponentManager::typeIds_;
+std::mutex ComponentManager::typeLock_;
 
 Component* ComponentManager::create_component(const char* componentName,
-	Object* owner) {
+	Object* owner, MemoryArena& arena) {
 	
 	// find component builder
 	auto found = builderMap_.find(componentName);
@@ -30,7 +32,7 @@ Component* ComponentManager::create_component(const char* componentName,
 	}
 	
 	// return new component created
-	return found->second->create_component(owner);
+	return found->second->create_component(owner, arena);
 } 
 
 const char* ComponentManager::key_to_type(const char* name)
@@ -51,6 +53,21 @@ const char* ComponentManager::type_to_key(const char* type)
 	return found->second.data();
 }
 
+unsigned ComponentManager::get_type_id(const char* type)
+{
+	// the first use of a type may come from any worker
+	std::lock_guard<std::mutex> guard(typeLock_);
+
+	auto found = typeIds_.find(type);
+	if (found != typeIds_.end())
+		return found->second;
+
+	// ids outlive the builders, the archetypes keep using them
+	unsigned id = static_cast<unsigned>(typeIds_.size());
+	typeIds_.insert(TypeIds::value_type(type, id));
+	return id;
+}
+
 void ComponentManager::clear_builders()
 {
 	// clear instances
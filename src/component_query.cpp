@@ -0,0 +1,43 @@
+/******************************************************************************/
+/*!
+\file   component_query.cpp
+\author Jeong Juyong
+\par    email: jaykop.jy\@gmail.com
+\date   2026/10/17(yy/mm/dd)
+
+\description
+Contains the methods of ComponentQuery class
+*/
+/******************************************************************************/
+
+#include <algorithm>
+#include <component_query.hpp>
+
+jeBegin
+
+ComponentQuery::ComponentQuery(const unsigned* ids, unsigned count)
+	: ids_(ids, ids + count), types_(ids, ids + count)
+{
+	std::sort(types_.begin(), types_.end());
+}
+
+unsigned ComponentQuery::size() const
+{
+	unsigned size = 0;
+	for (const auto& archetype : archetypes_)
+		size += archetype->size();
+
+	return size;
+}
+
+void ComponentQuery::match(ComponentArchetype* archetype)
+{
+	if (!archetype->has_all(types_))
+		return;
+
+	archetypes_.push_back(archetype);
+	for (const auto& id : ids_)
+		columns_.push_back(archetype->get_column(id));
+}
+
+jeEnd
@@ -0,0 +1,141 @@
+/******************************************************************************/
+/*!
+\file   contact_cache.cpp
+\author Jeong Juyong
+\par    email: jaykop.jy\@gmail.com
+\date   2026/10/17(yy/mm/dd)
+
+\description
+Contains the methods of ContactCache class
+*/
+/******************************************************************************/
+
+#include <contact_cache.hpp>
+#include <collider_2d.hpp>
+#include <functional>
+#include <algorithm>
+
+jeBegin
+
+size_t ContactCache::KeyHash::operator()(const Key& key) const
+{
+	size_t h1 = std::hash<Collider2D*>()(key.first);
+	size_t h2 = std::hash<Collider2D*>()(key.second);
+	return h1 ^ (h2 + 0x9e3779b9 + (h1 << 6) + (h1 >> 2));
+}
+
+ContactCache::Key ContactCache::make_key(Collider2D* a, Collider2D* b)
+{
+	return a < b ? Key{ a, b } : Key{ b, a };
+}
+
+bool ContactCache::find_or_add(Collider2D* a, Collider2D* b, ContactManifold*& manifold)
+{
+	// emplace builds the node before looking, so a cached pair would allocate every step
+	Key key = make_key(a, b);
+	auto found = manifolds_.find(key);
+	if (found != manifolds_.end())
+	{
+		manifold = &found->second;
+		return true;
+	}
+
+	manifold = &manifolds_.emplace(key, ContactManifold()).first->second;
+	manifold->a = a;
+	manifold->b = b;
+	manifold->id = nextId_++;
+	link(manifold);
+
+	return false;
+}
+
+void ContactCache::remove(Collider2D* collider, std::vector<Collider2D*>& touching)
+{
+	ContactManifold* manifold = collider->contacts_;
+	while (manifold)
+	{
+		int side = get_side(manifold, collider);
+		ContactManifold* next = manifold->next[side];
+
+		touching.push_back(side ? manifold->a : manifold->b);
+		unlink(manifold);
+		manifolds_.erase(make_key(manifold->a, manifold->b));
+
+		manifold = next;
+	}
+}
+
+void ContactCache::remove_stale(unsigned step, std::vector<ContactManifold>& removed)
+{
+	size_t first = removed.size();
+	for (auto it = manifolds_.begin(); it != manifolds_.end();)
+	{
+		const ContactManifold& manifold = it->second;
+
+		// sleeping pairs skip the narrow phase, keep them for the wake up
+		RigidBody* aBody = manifold.a->get_body();
+		RigidBody* bBody = manifold.b->get_body();
+		bool sleeping = aBody && bBody
+			&& (aBody->isStatic || !aBody->is_awake())
+			&& (bBody->isStatic || !bBody->is_awake());
+
+		if (manifold.lastStep != step && !sleeping)
+		{
+			removed.push_back(manifold);
+			unlink(&it->second);
+			it = manifolds_.erase(it);
+		}
+		else
+			++it;
+	}
+
+	std::sort(removed.begin() + first, removed.end(),
+		[](const ContactManifold& a, const ContactManifold& b) { return a.id < b.id; });
+}
+
+void ContactCache::clear()
+{
+	for (auto& m : manifolds_)
+		m.second.a->contacts_ = m.second.b->contacts_ = nullptr;
+
+	manifolds_.clear();
+	nextId_ = 0;
+}
+
+void ContactCache::link(ContactManifold* manifold)
+{
+	Collider2D* colliders[] = { manifold->a, manifold->b };
+	for (int side = 0; side < 2; ++side)
+	{
+		Collider2D* collider = colliders[side];
+		ContactManifold* head = collider->contacts_;
+
+		manifold->prev[side] = nullptr;
+		manifold->next[side] = head;
+		if (head)
+			head->prev[get_side(head, collider)] = manifold;
+
+		collider->contacts_ = manifold;
+	}
+}
+
+void ContactCache::unlink(ContactManifold* manifold)
+{
+	Collider2D* colliders[] = { manifold->a, manifold->b };
+	for (int side = 0; side < 2; ++side)
+	{
+		Collider2D* collider = colliders[side];
+		ContactManifold* prev = manifold->prev[side];
+		ContactManifold* next = manifold->next[side];
+
+		if (prev)
+			prev->next[get_side(prev, collider)] = next;
+		else
+			collider->contacts_ = next;
+
+		if (next)
+			next->prev[get_side(next, collider)] = prev;
+	}
+}
+
+jeEnd
@@ -27,7 +27,7 @@ DebugRenderer::~DebugRenderer(void)
 void DebugRenderer::add_to_system() 
 {
 	// todo: change this to happen all the time
-	set_parent_renderer();
+	find_body();
 	GraphicSystem::add_renderer(this);
 }
 
@@ -46,9 +46,7 @@ void DebugRenderer::draw(float /*dt*/)
 	Shader* shader = GraphicSystem::shader_[GraphicSystem::DEBUG];
 	shader->use();
 
-	shader->set_matrix("m4_translate", mat4::translate(transform_->position));
-	shader->set_matrix("m4_scale", mat4::scale(transform_->scale));
-	shader->set_matrix("m4_rotate", transform_->orientation.to_mat4());
+	shader->set_matrix("m4_model", get_render_matrix());
 	//shader->set_vec3("v3_cameraPosition", camera->position);
 	shader->set_bool("boolean_bilboard", (status & IS_BILBOARD) == IS_BILBOARD);
 	//shader->set_bool("boolean_flip", (status & IS_FLIPPED) == IS_FLIPPED);
@@ -92,16 +90,6 @@ void DebugRenderer::draw(float /*dt*/)
 		shader->set_matrix("m4_viewport", viewport);
 	}
 
-	bool isHerited = parent_ != nullptr;
-	shader->set_bool("boolean_herited", isHerited);
-	if (isHerited)
-	{
-		Transform* pTransform = parent_->get_transform();
-		shader->set_matrix("m4_parentTranslate", mat4::translate(pTransform->position));
-		shader->set_matrix("m4_parentScale", mat4::scale(pTransform->scale));
-		shader->set_matrix("m4_parentRotate", pTransform->orientation.to_mat4());
-	}
-
 	glEnable(GL_DEPTH_TEST);
 
 	if (!vertices_.empty()) {
@@ -57,7 +57,7 @@ void Emitter::add_to_system() {
 	else
 		jeDebugPrint("!Emitter - Already allocated.\n");
 
-	set_parent_renderer();
+	find_body();
 	GraphicSystem::add_renderer(this);
 }
 
@@ -120,16 +120,6 @@ void Emitter::draw(float dt)
 			shader->set_matrix("m4_viewport", viewport);
 		}
 
-		bool isHerited = parent_ != nullptr;
-		shader->set_bool("boolean_herited", isHerited);
-		if (isHerited)
-		{
-			Transform* pTransform = parent_->get_transform();
-			shader->set_matrix("m4_parentTranslate", mat4::translate(pTransform->position));
-			shader->set_matrix("m4_parentScale", mat4::scale(pTransform->scale));
-			shader->set_matrix("m4_parentRotate", pTransform->orientation.to_mat4());
-		}
-
 		glDepthMask(GL_FALSE);
 		glEnable(GL_BLEND);
 		glEnable(GL_DEPTH_TEST);
@@ -15,6 +15,7 @@ Contains the methods of GraphicSystem class
 #include <scene_manager.hpp>
 #include <asset_manager.hpp>
 #include <scene.hpp>
+#include <object_manager.hpp>
 #include <shader.hpp>
 #include <math_util.hpp>
 #include <mat4.hpp>
@@ -175,6 +176,9 @@ Camera* GraphicSystem::get_camera()
 
 void GraphicSystem::initialize() {
 
+	// the lights are found in the archetypes of the scene
+	lights_ = Lights(ObjectManager::get_objects()->archetypes);
+
 	// set main camera
 	if (!mainCamera_ && !(cameras_.empty()))
 		mainCamera_ = *cameras_.begin();
@@ -246,8 +250,7 @@ void GraphicSystem::update(float dt) {
 
 void GraphicSystem::close() {
 
-	lights_.clear();
-	//lights_.shrink_to_fit();
+	lights_ = Lights();
 
 	cameras_.clear();
 	//cameras_.shrink_to_fit();
@@ -445,11 +448,6 @@ void GraphicSystem::add_camera(Camera* camera)
 	cameras_.emplace_back(camera);
 }
 
-void GraphicSystem::add_light(Light* light)
-{
-	lights_.emplace_back(light);
-}
-
 void GraphicSystem::remove_renderer(Renderer* model)
 {
 	renderers_.erase(std::remove(renderers_.begin(), renderers_.end(), model), renderers_.end());
@@ -460,11 +458,6 @@ void GraphicSystem::remove_camera(Camera* camera)
 	cameras_.erase(std::remove(cameras_.begin(), cameras_.end(), camera), cameras_.end());
 }
 
-void GraphicSystem::remove_light(Light* light)
-{
-	lights_.erase(std::remove(lights_.begin(), lights_.end(), light), lights_.end());
-}
-
 void GraphicSystem::pause()
 {
 	Graphic grp;
@@ -481,7 +474,7 @@ void GraphicSystem::pause()
 	// 
 	renderers_.clear();
 	cameras_.clear();
-	lights_.clear();
+	lights_ = Lights();
 }
 
 void GraphicSystem::resume()
@@ -503,93 +496,95 @@ void GraphicSystem::resume()
 
 void GraphicSystem::update_lights(float dt)
 {
-	for (unsigned i = 0; i < lights_.size(); ++i)
-	{
+	unsigned i = 0;
+	lights_.for_each([&](Object*, Light* light) {
+
 		Shader* shader = shader_[SPRITE];
 		shader->use();
 
 		// Update shader uniform info
 		std::string str("light[" + std::to_string(i));
-		shader->set_bool((str + activate).c_str(), lights_[i]->activate);
+		shader->set_bool((str + activate).c_str(), light->activate);
 
 		// Set strings as a static
-		if (lights_[i]->activate) {
+		if (light->activate) {
 
 			/*Calculate the light max and set the radius for light volume optimization*/
 			// Calculate the light max
-			//float ambientMax = std::fmaxf(std::fmaxf(lights_[i]->ambient.x, lights_[i]->ambient.y),lights_[i]->ambient.z);
-			//float diffuseMax = std::fmaxf(std::fmaxf(lights_[i]->diffuse.x, lights_[i]->diffuse.y),lights_[i]->diffuse.z);
-			//float speculaMax = std::fmaxf(std::fmaxf(lights_[i]->specular.x, lights_[i]->specular.y), lights_[i]->specular.z);
+			//float ambientMax = std::fmaxf(std::fmaxf(light->ambient.x, light->ambient.y),light->ambient.z);
+			//float diffuseMax = std::fmaxf(std::fmaxf(light->diffuse.x, light->diffuse.y),light->diffuse.z);
+			//float speculaMax = std::fmaxf(std::fmaxf(light->specular.x, light->specular.y), light->specular.z);
 			//float lightMax = std::fmaxf(std::fmaxf(ambientMax, diffuseMax), speculaMax);
 
 			// Get radius
-			float lightConstant = lights_[i]->constant;
-			float lightLinear = lights_[i]->linear;
-			float lightQuadratic = lights_[i]->quadratic;
+			float lightConstant = light->constant;
+			float lightLinear = light->linear;
+			float lightQuadratic = light->quadratic;
 			//float lightRadius = (-lightLinear + std::sqrtf(lightLinear * lightLinear
 			//	- 4 * lightQuadratic * (lightConstant - (256.f / 5.f) * lightMax))) * 0.5f * lightQuadratic;
 
 			// Update light direction
-			shader->set_int((str + type).c_str(), static_cast<int>(lights_[i]->type));
-			shader->set_vec3((str + position).c_str(), lights_[i]->transform_->position);
+			shader->set_int((str + type).c_str(), static_cast<int>(light->type));
+			shader->set_vec3((str + position).c_str(), light->transform_->position);
 			shader->set_float((str + constant).c_str(), lightConstant);
 			shader->set_float((str + linear).c_str(), lightLinear);
 			shader->set_float((str + quadratic).c_str(), lightQuadratic);
-			shader->set_vec3((str + aColor).c_str(), lights_[i]->ambient);
-			shader->set_vec3((str + sColor).c_str(), lights_[i]->specular);
-			shader->set_vec3((str + dColor).c_str(), lights_[i]->diffuse);
-			shader->set_float((str + aIntense).c_str(), lights_[i]->ambientIntensity);
-			shader->set_float((str + dIntense).c_str(), lights_[i]->diffuseIntensity);
-			shader->set_float((str + sIntense).c_str(), lights_[i]->specularIntensity);
-			shader->set_float((str + fallOff).c_str(), lights_[i]->fallOff);
+			shader->set_vec3((str + aColor).c_str(), light->ambient);
+			shader->set_vec3((str + sColor).c_str(), light->specular);
+			shader->set_vec3((str + dColor).c_str(), light->diffuse);
+			shader->set_float((str + aIntense).c_str(), light->ambientIntensity);
+			shader->set_float((str + dIntense).c_str(), light->diffuseIntensity);
+			shader->set_float((str + sIntense).c_str(), light->specularIntensity);
+			shader->set_float((str + fallOff).c_str(), light->fallOff);
 			//shader->set_float((str + radius).c_str(), lightRadius);
-			shader->set_float((str + innerAngle).c_str(), Math::deg_to_rad(lights_[i]->innerAngle));
-			shader->set_float((str + outerAngle).c_str(), Math::deg_to_rad(lights_[i]->outerAngle));
+			shader->set_float((str + innerAngle).c_str(), Math::deg_to_rad(light->innerAngle));
+			shader->set_float((str + outerAngle).c_str(), Math::deg_to_rad(light->outerAngle));
 		}
 
 		shader = shader_[MODEL];
 		shader->use();
 
 		// Update shader uniform info
-		shader->set_bool((str + activate).c_str(), lights_[i]->activate);
+		shader->set_bool((str + activate).c_str(), light->activate);
 
 		// Set strings as a static
-		if (lights_[i]->activate) {
+		if (light->activate) {
 
 			/*Calculate the light max and set the radius for light volume optimization*/
 			// Calculate the light max
-			//float ambientMax = std::fmaxf(std::fmaxf(lights_[i]->ambient.x, lights_[i]->ambient.y),lights_[i]->ambient.z);
-			//float diffuseMax = std::fmaxf(std::fmaxf(lights_[i]->diffuse.x, lights_[i]->diffuse.y),lights_[i]->diffuse.z);
-			//float speculaMax = std::fmaxf(std::fmaxf(lights_[i]->specular.x, lights_[i]->specular.y), lights_[i]->specular.z);
+			//float ambientMax = std::fmaxf(std::fmaxf(light->ambient.x, light->ambient.y),light->ambient.z);
+			//float diffuseMax = std::fmaxf(std::fmaxf(light->diffuse.x, light->diffuse.y),light->diffuse.z);
+			//float speculaMax = std::fmaxf(std::fmaxf(light->specular.x, light->specular.y), light->specular.z);
 			//float lightMax = std::fmaxf(std::fmaxf(ambientMax, diffuseMax), speculaMax);
 
 			// Get radius
-			float lightConstant = lights_[i]->constant;
-			float lightLinear = lights_[i]->linear;
-			float lightQuadratic = lights_[i]->quadratic;
+			float lightConstant = light->constant;
+			float lightLinear = light->linear;
+			float lightQuadratic = light->quadratic;
 			//float lightRadius = (-lightLinear + std::sqrtf(lightLinear * lightLinear
 			//	- 4 * lightQuadratic * (lightConstant - (256.f / 5.f) * lightMax))) * 0.5f * lightQuadratic;
 
 			// Update light direction
-			shader->set_int((str + type).c_str(), static_cast<int>(lights_[i]->type));
-			shader->set_vec3((str + position).c_str(), lights_[i]->transform_->position);
+			shader->set_int((str + type).c_str(), static_cast<int>(light->type));
+			shader->set_vec3((str + position).c_str(), light->transform_->position);
 			shader->set_float((str + constant).c_str(), lightConstant);
 			shader->set_float((str + linear).c_str(), lightLinear);
 			shader->set_float((str + quadratic).c_str(), lightQuadratic);
-			shader->set_vec3((str + aColor).c_str(), lights_[i]->ambient);
-			shader->set_vec3((str + sColor).c_str(), lights_[i]->specular);
-			shader->set_vec3((str + dColor).c_str(), lights_[i]->diffuse);
-			shader->set_float((str + aIntense).c_str(), lights_[i]->ambientIntensity);
-			shader->set_float((str + dIntense).c_str(), lights_[i]->diffuseIntensity);
-			shader->set_float((str + sIntense).c_str(), lights_[i]->specularIntensity);
-			shader->set_float((str + fallOff).c_str(), lights_[i]->fallOff);
+			shader->set_vec3((str + aColor).c_str(), light->ambient);
+			shader->set_vec3((str + sColor).c_str(), light->specular);
+			shader->set_vec3((str + dColor).c_str(), light->diffuse);
+			shader->set_float((str + aIntense).c_str(), light->ambientIntensity);
+			shader->set_float((str + dIntense).c_str(), light->diffuseIntensity);
+			shader->set_float((str + sIntense).c_str(), light->specularIntensity);
+			shader->set_float((str + fallOff).c_str(), light->fallOff);
 			//shader->set_float((str + radius).c_str(), lightRadius);
-			shader->set_float((str + innerAngle).c_str(), Math::deg_to_rad(lights_[i]->innerAngle));
-			shader->set_float((str + outerAngle).c_str(), Math::deg_to_rad(lights_[i]->outerAngle));
+			shader->set_float((str + innerAngle).c_str(), Math::deg_to_rad(light->innerAngle));
+			shader->set_float((str + outerAngle).c_str(), Math::deg_to_rad(light->outerAngle));
 		}
 
-		lights_[i]->draw(dt);
-	}
+		light->draw(dt);
+		++i;
+	});
 }
 
 void GraphicSystem::initialize_shaders()
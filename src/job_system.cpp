@@ -0,0 +1,297 @@
+/******************************************************************************/
+/*!
+\file   job_system.cpp
+\author Jeong Juyong
+\par    email: jaykop.jy\@gmail.com
+\date   2026/10/17(yy/mm/dd)
+
+\description
+Contains the methods of JobSystem class
+*/
+/******************************************************************************/
+
+#include <algorithm>
+#include <job_system.hpp>
+
+jeBegin
+
+std::vector<JobSystem::Worker*> JobSystem::workers_;
+std::vector<std::thread> JobSystem::threads_;
+std::deque<Job> JobSystem::mainJobs_;
+std::mutex JobSystem::mainLock_, JobSystem::sleepLock_;
+std::condition_variable JobSystem::wake_;
+std::atomic<unsigned> JobSystem::queued_(0);
+std::atomic<bool> JobSystem::running_(false);
+std::thread::id JobSystem::mainThread_;
+thread_local unsigned JobSystem::workerIndex_ = 0;
+
+void JobSystem::initialize(unsigned threadCount)
+{
+	if (!threadCount)
+		threadCount = std::thread::hardware_concurrency();
+	if (!threadCount)
+		threadCount = 1;
+
+	mainThread_ = std::this_thread::get_id();
+	workerIndex_ = 0;
+	running_ = true;
+
+	for (unsigned i = 0; i < threadCount; ++i)
+		workers_.emplace_back(new Worker);
+
+	// the main thread is the worker 0
+	for (unsigned i = 1; i < threadCount; ++i)
+		threads_.emplace_back(work, i);
+}
+
+void JobSystem::update()
+{
+	// the jobs added meanwhile wait for the next update
+	std::deque<Job> jobs;
+	{
+		std::lock_guard<std::mutex> guard(mainLock_);
+		jobs.swap(mainJobs_);
+	}
+
+	for (auto& job : jobs)
+		execute(job);
+}
+
+void JobSystem::close()
+{
+	{
+		std::lock_guard<std::mutex> guard(sleepLock_);
+		running_ = false;
+	}
+	wake_.notify_all();
+
+	for (auto& thread : threads_)
+		thread.join();
+
+	threads_.clear();
+
+	// what is left runs here, so no counter keeps waiting
+	for (auto& worker : workers_)
+	{
+		for (auto& job : worker->jobs)
+			execute(job);
+
+		delete worker;
+	}
+
+	workers_.clear();
+	queued_ = 0;
+
+	update();
+}
+
+void JobSystem::run(const JobFunction& function, JobCounter* counter)
+{
+	if (counter)
+		++counter->pending_;
+
+	Job job;
+	job.function = function;
+	job.counter = counter;
+	enqueue(job);
+}
+
+void JobSystem::run_after(JobCounter& dependency, const JobFunction& function, JobCounter* counter)
+{
+	{
+		std::lock_guard<std::mutex> guard(dependency.lock_);
+		if (dependency.pending_) {
+
+			// counted from now, so waiting on the counter covers it
+			if (counter)
+				++counter->pending_;
+
+			Job job;
+			job.function = function;
+			job.counter = counter;
+			dependency.continuations_.emplace_back(job);
+			return;
+		}
+	}
+
+	run(function, counter);
+}
+
+void JobSystem::run_on_main(const JobFunction& function, JobCounter* counter)
+{
+	if (counter)
+		++counter->pending_;
+
+	Job job;
+	job.function = function;
+	job.counter = counter;
+
+	std::lock_guard<std::mutex> guard(mainLock_);
+	mainJobs_.emplace_back(job);
+}
+
+void JobSystem::wait(JobCounter& counter)
+{
+	unsigned index = workerIndex_;
+	while (counter.pending_)
+	{
+		if (!execute_one(index))
+			std::this_thread::yield();
+	}
+
+	// the last finisher may still hold the lock
+	std::lock_guard<std::mutex> guard(counter.lock_);
+}
+
+void JobSystem::parallel_for(unsigned count, unsigned chunks, const RangeJob& job)
+{
+	struct Split {
+		const RangeJob* job;
+		unsigned count, size;
+	};
+
+	if (!chunks)
+		chunks = 1;
+
+	// a pointer and an index, small enough to skip the allocation of the function
+	Split split = { &job, count, (count + chunks - 1) / chunks };
+	JobCounter counter;
+
+	for (unsigned i = 1; i < chunks; ++i)
+	{
+		const Split* s = &split;
+		run([s, i]() {
+			unsigned begin = i * s->size;
+			(*s->job)(i, begin, std::min(begin + s->size, s->count));
+		}, &counter);
+	}
+
+	job(0, 0, std::min(split.size, count));
+	wait(counter);
+}
+
+void JobSystem::enqueue(const Job& job)
+{
+	// not initialized, nobody else would run it
+	if (workers_.empty()) {
+		Job inline_ = job;
+		execute(inline_);
+		return;
+	}
+
+	Worker* worker = workers_[workerIndex_];
+	{
+		std::lock_guard<std::mutex> guard(worker->lock);
+		worker->jobs.emplace_back(job);
+	}
+
+	// taking the lock keeps a worker from missing the wake up
+	// between checking the queue and going to sleep
+	{
+		std::lock_guard<std::mutex> guard(sleepLock_);
+		++queued_;
+	}
+	wake_.notify_one();
+}
+
+void JobSystem::finish(JobCounter* counter)
+{
+	// the last decrement and taking the continuations go together,
+	// wait() takes the lock too before the counter can go away
+	std::vector<Job> continuations;
+	{
+		std::lock_guard<std::mutex> guard(counter->lock_);
+		if (--counter->pending_)
+			return;
+
+		continuations.swap(counter->continuations_);
+	}
+
+	// already counted when they were added
+	for (const auto& job : continuations)
+		enqueue(job);
+}
+
+void JobSystem::execute(Job& job)
+{
+	job.function();
+
+	if (job.counter)
+		finish(job.counter);
+}
+
+bool JobSystem::execute_one(unsigned index)
+{
+	Job job;
+	if (pop(index, job) || steal(index, job)
+		|| (is_main_thread() && pop_main(job))) {
+		execute(job);
+		return true;
+	}
+
+	return false;
+}
+
+bool JobSystem::pop(unsigned index, Job& job)
+{
+	if (workers_.empty())
+		return false;
+
+	// the newest one, its data is likely still in the cache
+	Worker* worker = workers_[index];
+	std::lock_guard<std::mutex> guard(worker->lock);
+	if (worker->jobs.empty())
+		return false;
+
+	job = std::move(worker->jobs.back());
+	worker->jobs.pop_back();
+	--queued_;
+	return true;
+}
+
+bool JobSystem::steal(unsigned index, Job& job)
+{
+	unsigned count = static_cast<unsigned>(workers_.size());
+	for (unsigned i = 1; i < count; ++i)
+	{
+		// the oldest one, usually the biggest piece of work left
+		Worker* victim = workers_[(index + i) % count];
+		std::lock_guard<std::mutex> guard(victim->lock);
+		if (victim->jobs.empty())
+			continue;
+
+		job = std::move(victim->jobs.front());
+		victim->jobs.pop_front();
+		--queued_;
+		return true;
+	}
+
+	return false;
+}
+
+bool JobSystem::pop_main(Job& job)
+{
+	std::lock_guard<std::mutex> guard(mainLock_);
+	if (mainJobs_.empty())
+		return false;
+
+	job = std::move(mainJobs_.front());
+	mainJobs_.pop_front();
+	return true;
+}
+
+void JobSystem::work(unsigned index)
+{
+	workerIndex_ = index;
+
+	while (running_)
+	{
+		if (execute_one(index))
+			continue;
+
+		std::unique_lock<std::mutex> lock(sleepLock_);
+		wake_.wait(lock, [] { return !running_ || queued_ > 0; });
+	}
+}
+
+jeEnd
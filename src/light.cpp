@@ -51,9 +51,7 @@ void Light::draw(float /*dt*/)
     Shader* shader = GraphicSystem::shader_[GraphicSystem::LIGHT];
     shader->use();
 
-    shader->set_matrix("m4_translate", mat4::translate(transform_->position));
-    shader->set_matrix("m4_scale", mat4::scale(transform_->scale));
-    shader->set_matrix("m4_rotate", transform_->orientation.to_mat4());
+    shader->set_matrix("m4_model", get_render_matrix());
     shader->set_bool("boolean_bilboard", (status & IS_BILBOARD) == IS_BILBOARD);
     shader->set_vec3("v3_color", diffuse);
 
@@ -93,16 +91,6 @@ void Light::draw(float /*dt*/)
         shader->set_matrix("m4_viewport", viewport);
     }
 
-    bool isHerited = parent_ != nullptr;
-    shader->set_bool("boolean_herited", isHerited);
-    if (isHerited)
-    {
-        Transform* pTransform = parent_->get_transform();
-        shader->set_matrix("m4_parentTranslate", mat4::translate(pTransform->position));
-        shader->set_matrix("m4_parentScale", mat4::scale(pTransform->scale));
-        shader->set_matrix("m4_parentRotate", pTransform->orientation.to_mat4());
-    }
-
     //if (pModel->pMaterial_ && isLight_)
     //	LightingEffectPipeline(pModel->pMaterial_);
 
@@ -119,13 +107,12 @@ void Light::draw(float /*dt*/)
 
 void Light::add_to_system()
 {
-	set_parent_renderer();
-	GraphicSystem::add_light(this);
+	// the system finds the light through the view of the scene
+	find_body();
 }
 
 void Light::remove_from_system()
 {
-	GraphicSystem::remove_light(this);
 }
 
 void Light::load(const rapidjson::Value& /*data*/)
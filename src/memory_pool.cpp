@@ -0,0 +1,122 @@
+/******************************************************************************/
+/*!
+\file   memory_pool.cpp
+\author Jeong Juyong
+\par    email: jaykop.jy\@gmail.com
+\date   2026/10/17(yy/mm/dd)
+
+\description
+Contains the methods of MemoryPool and MemoryArena class
+*/
+/******************************************************************************/
+
+#include <new>
+#include <debug_tools.hpp>
+#include <memory_pool.hpp>
+
+jeBegin
+
+std::atomic<unsigned> MemoryArena::indexCount_(0);
+
+MemoryPool::MemoryPool(const char* name, size_t size)
+	: name_(name), blockSize_(HEADER_SIZE + size)
+{
+	// keep the next header aligned as well
+	const size_t align = alignof(std::max_align_t);
+	blockSize_ = (blockSize_ + align - 1) / align * align;
+}
+
+MemoryPool::~MemoryPool()
+{
+	release();
+}
+
+void* MemoryPool::allocate()
+{
+	if (!freeList_)
+		add_slab();
+
+	Header* header = freeList_;
+	freeList_ = header->next;
+
+	if (++used_ > highWater_)
+		highWater_ = used_;
+
+	return reinterpret_cast<char*>(header) + HEADER_SIZE;
+}
+
+void MemoryPool::free(void* block)
+{
+	Header* header = reinterpret_cast<Header*>(static_cast<char*>(block) - HEADER_SIZE);
+	header->next = freeList_;
+	freeList_ = header;
+	--used_;
+}
+
+void MemoryPool::release()
+{
+	DEBUG_ASSERT(used_ == 0, "Releasing the blocks still in use!");
+
+	for (auto& slab : slabs_)
+		::operator delete(slab);
+
+	slabs_.clear();
+	freeList_ = nullptr;
+	used_ = 0;
+}
+
+void MemoryPool::add_slab()
+{
+	char* slab = static_cast<char*>(::operator new(blockSize_ * BLOCKS_PER_SLAB));
+	slabs_.emplace_back(slab);
+
+	// link the new blocks in the address order
+	for (unsigned i = BLOCKS_PER_SLAB; i-- > 0;)
+	{
+		Header* header = reinterpret_cast<Header*>(slab + i * blockSize_);
+		header->pool = this;
+		header->next = freeList_;
+		freeList_ = header;
+	}
+}
+
+void* MemoryPool::allocate(size_t size, MemoryPool* pool)
+{
+	// a derived class without its own pool is bigger than the block
+	if (pool && size + HEADER_SIZE <= pool->blockSize_)
+		return pool->allocate();
+
+	Header* header = static_cast<Header*>(::operator new(HEADER_SIZE + size));
+	header->pool = nullptr;
+	return reinterpret_cast<char*>(header) + HEADER_SIZE;
+}
+
+void MemoryPool::deallocate(void* instance)
+{
+	if (!instance)
+		return;
+
+	Header* header = reinterpret_cast<Header*>(static_cast<char*>(instance) - HEADER_SIZE);
+	if (header->pool)
+		header->pool->free(instance);
+	else
+		::operator delete(header);
+}
+
+MemoryArena::~MemoryArena()
+{
+	for (auto& pool : pools_)
+		delete pool;
+}
+
+void MemoryArena::release()
+{
+	// the pools stay, so the high water marks survive the scene
+	for (auto& pool : pools_)
+	{
+		if (pool)
+			pool->release();
+	}
+}
+
+jeEnd
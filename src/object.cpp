@@ -12,83 +12,129 @@ Contains the methods of Object class
 */
 /******************************************************************************/
 
+#include <cstring>
+#include <algorithm>
 #include <object.hpp>
 #include <component.hpp>
 #include <debug_tools.hpp>
 #include <object_manager.hpp>
 #include <component_manager.hpp>
+#include <component_archetype.hpp>
+#include <transform_system.hpp>
+#include <collider_2d.hpp>
+#include <rigidbody.hpp>
 
 jeBegin
 
-Object::Object(const char* name)
-	:name_(name), active_(true), parent_(nullptr)
+Object::Object(const char* name, ObjectMap& objects)
+	:active_(true), parent_(nullptr), name_(name)
 {
 	id_ = ObjectManager::assign_id();
+	arena_ = &objects.arena;
+	storage_ = &objects.archetypes;
+	storage_->add(this);
 }
 
 Object::~Object()
 {
 	clear_component();
 	clear_children();
+	storage_->remove(this);
 }
 
 void Object::register_components()
 {
-	for (const auto& component : components_)
-		component.second->add_to_system();
+	// a component can add another one while registering, which moves the row
+	std::vector<Component*> components;
+	for (unsigned c = 0; c < archetype_->get_signature().size(); ++c)
+		components.push_back(archetype_->at(row_, c));
+
+	for (const auto& component : components)
+		component->add_to_system();
+
+	registered_ = true;
 }
 
 const char* Object::get_name() const
 {
-	return name_.c_str();
+	return name_;
 }
 
 void Object::add_component(const char* componentName)
 {
 	const char* typeName = ComponentManager::key_to_type(componentName);
-	const auto& found = components_.find(typeName);
-
-	DEBUG_ASSERT(found == components_.end(), "Trying to add an existing component!");
-
-	Component* newComponent = ComponentManager::create_component(typeName, this);
-	components_.insert(Components::value_type(typeName, newComponent));
+	attach_component(ComponentManager::get_type_id(typeName), typeName);
 }
 
 Component* Object::get_component(const char* componentName)
 {
 	const char* typeName = ComponentManager::key_to_type(componentName);
-	const auto& found = components_.find(typeName);
+	Component* found = find_component(ComponentManager::get_type_id(typeName));
 
-	DEBUG_ASSERT(found != components_.end(), "No such name of component!");
+	DEBUG_ASSERT(found != nullptr, "No such name of component!");
 
-	return found->second;
+	return found;
 }
 
 bool Object::has_component(const char* componentName)
 {
 	const char* typeName = ComponentManager::key_to_type(componentName);
-	const auto& found = components_.find(typeName);
-
-	return found != components_.end();
+	return find_component(ComponentManager::get_type_id(typeName)) != nullptr;
 }
 
 void Object::remove_component(const char* componentName)
 {
-	const char* typeName = ComponentManager::key_to_type(componentName);
-	const auto& found = components_.find(typeName);
+	detach_component(ComponentManager::get_type_id(ComponentManager::key_to_type(componentName)));
+}
 
-	DEBUG_ASSERT(found != components_.end(), "No such name of component!");
+void Object::attach_component(unsigned typeId, const char* typeName)
+{
+	if (find_component(typeId)) {
+		jeDebugPrint("Trying to add an existing component!");
+		return;
+	}
 
-	delete found->second;
-	found->second = nullptr;
+	Component* newComponent = ComponentManager::create_component(typeName, this, *arena_);
+	if (newComponent)
+		storage_->add_component(this, typeId, newComponent);
+}
+
+void Object::attach_live_component(const char* typeName)
+{
+	unsigned typeId = ComponentManager::get_type_id(typeName);
+	if (find_component(typeId)) {
+		jeDebugPrint("Trying to add an existing component!");
+		return;
+	}
+
+	attach_component(typeId, typeName);
+
+	Component* added = find_component(typeId);
+	if (added && registered_)
+		added->add_to_system();
+}
+
+void Object::detach_component(unsigned typeId)
+{
+	// out of the set first, so the destructor does not find itself
+	Component* component = storage_->remove_component(this, typeId);
+
+	DEBUG_ASSERT(component != nullptr, "No such name of component!");
+
+	delete component;
 }
 
 void Object::add_child(Object* child)
 {
-	const auto& found = children_.find(child->get_name());
+	const auto& found = std::find(children_.begin(), children_.end(), child->get_handle());
 	DEBUG_ASSERT(found == children_.end(), "Trying to add an existing object!");
-	children_.insert(Children::value_type(child->get_name(), child));
+	DEBUG_ASSERT(!child->has_component<Collider2D>() && !child->has_component<RigidBody>(),
+		"The physics works on the root objects only!");
+	children_.push_back(child->get_handle());
 	child->set_parent(this);
+
+	// the world matrix of the child follows this one from now on
+	TransformSystem::update_parent(child);
 }
 
 void Object::remove_child(const char* name)
@@ -98,15 +144,27 @@ void Object::remove_child(const char* name)
 
 bool Object::has_child(const char* name)
 {
-	const auto& found = children_.find(name);
-	return found != children_.end();
+	return find_child(name) != nullptr;
 }
 
 Object* Object::get_child(const char* name)
 {
-	const auto& found = children_.find(name);
-	DEBUG_ASSERT(found != children_.end(), "No such child object!");
-	return found->second;
+	Object* found = find_child(name);
+	DEBUG_ASSERT(found != nullptr, "No such child object!");
+	return found;
+}
+
+Object* Object::find_child(const char* name) const
+{
+	// the handles of the removed children resolve to nullptr
+	for (const auto& handle : children_)
+	{
+		Object* child = ObjectManager::get_object(handle);
+		if (child && !strcmp(child->get_name(), name))
+			return child;
+	}
+
+	return nullptr;
 }
 
 void Object::clear_children()
@@ -119,16 +177,19 @@ void Object::clear_children()
 
 void Object::clear_component()
 {
-	// Clear all components in the list
-	for (auto& component : components_) {
-
-		if (component.second) {
-			delete component.second;
-			component.second = nullptr;
-		}
+	// the slots are emptied one by one,
+	// so the destructors still find the components left
+	const Signature& signature = archetype_->get_signature();
+	for (unsigned c = 0; c < signature.size(); ++c) {
+
+		Component*& slot = archetype_->at(row_, c);
+		Component* component = slot;
+		slot = nullptr;
+		lookup_[signature[c]] = nullptr;
+		delete component;
 	}
 
-	components_.clear();
+	storage_->move(this, storage_->find_or_create(Signature()));
 }
 
 jeEnd
\ No newline at end of file
@@ -19,16 +19,35 @@ jeBegin
 
 int ObjectManager::idGenerator_ = 0;
 ObjectMap* ObjectManager::objects_ = nullptr;
+std::vector<ObjectManager::Slot> ObjectManager::slots_;
+unsigned ObjectManager::freeSlot_ = ObjectHandle::NULL_INDEX;
 
 Object* ObjectManager::create_object(const char* name)
 {
-	auto found = objects_->find(name);
-	if (found != objects_->end()) {
-		jeDebugPrint("The object with same name is already in the map!");
-		return nullptr;
+	// unnamed objects share the empty name
+	auto named = objects_->names.end();
+	const char* internedName = "";
+
+	if (name && *name) {
+
+		auto inserted = objects_->names.insert(ObjectMap::NameIndex::value_type(name, ObjectHandle()));
+		if (!inserted.second) {
+			jeDebugPrint("The object with same name is already in the map!");
+			return nullptr;
+		}
+
+		// the key does not move while it is in the index
+		named = inserted.first;
+		internedName = named->first.c_str();
 	}
 
-	Object* newObject = new Object(name);
+	Object* newObject = new (objects_->arena.get_pool<Object>()) Object(internedName, *objects_);
+	newObject->handle_ = allocate_slot(newObject);
+	newObject->order_ = static_cast<unsigned>(objects_->objects.size());
+	objects_->objects.emplace_back(newObject);
+
+	if (named != objects_->names.end())
+		named->second = newObject->handle_;
 
 	// automatically transform is added
 	newObject->add_component<Transform>();
@@ -38,33 +57,69 @@ Object* ObjectManager::create_object(const char* name)
 
 void ObjectManager::remove_object(const char* name)
 {
-	auto toRemove = objects_->find(name);
-	DEBUG_ASSERT(toRemove != objects_->end(), "No such name of object!");
+	auto toRemove = objects_->names.find(name);
+	DEBUG_ASSERT(toRemove != objects_->names.end(), "No such name of object!");
 
-	// delete the instance
-	delete toRemove->second;
-	toRemove->second = nullptr;
-
-	// remove from the container
-	objects_->erase(toRemove);
+	remove_object(toRemove->second);
 }
 
 void ObjectManager::remove_object(Object* object)
 {
-	remove_object(object->get_name());
+	remove_object(object->get_handle());
+}
+
+void ObjectManager::remove_object(ObjectHandle handle)
+{
+	Object* toRemove = get_object(handle);
+	if (!toRemove) {
+		jeDebugPrint("The object is already removed!");
+		return;
+	}
+
+	// the last object fills the hole
+	auto& objects = objects_->objects;
+	unsigned order = toRemove->order_;
+	objects[order] = objects.back();
+	objects[order]->order_ = order;
+	objects.pop_back();
+
+	// the name is interned in the index, so it goes after the object
+	auto named = objects_->names.end();
+	if (*toRemove->get_name())
+		named = objects_->names.find(toRemove->get_name());
+
+	free_slot(handle);
+	delete toRemove;
+
+	if (named != objects_->names.end())
+		objects_->names.erase(named);
 }
 
 Object* ObjectManager::get_object(const char* name)
 {
-	auto toReturn = objects_->find(name);
-	DEBUG_ASSERT(toReturn != objects_->end(), "No such name of object!");
-	return toReturn->second;
+	auto toReturn = objects_->names.find(name);
+	DEBUG_ASSERT(toReturn != objects_->names.end(), "No such name of object!");
+	return get_object(toReturn->second);
 }
 
 bool ObjectManager::has_object(const char* name)
 {
-	auto toReturn = objects_->find(name);
-	return toReturn != objects_->end();
+	auto toReturn = objects_->names.find(name);
+	return toReturn != objects_->names.end();
+}
+
+Object* ObjectManager::get_object(ObjectHandle handle)
+{
+	if (handle.index >= slots_.size())
+		return nullptr;
+
+	const Slot& slot = slots_[handle.index];
+	return slot.generation == handle.generation ? slot.object : nullptr;
+}
+
+bool ObjectManager::has_object(ObjectHandle handle)
+{
+	return get_object(handle) != nullptr;
 }
 
 ObjectMap* ObjectManager::get_objects()
@@ -72,15 +127,25 @@ ObjectMap* ObjectManager::get_objects()
 	return objects_;
 }
 
+void ObjectManager::set_objects(ObjectMap* objects)
+{
+	objects_ = objects;
+}
+
 void ObjectManager::clear_objects()
 {
-	for (auto& obj : *objects_) {
-		
-		delete obj.second;
-		obj.second = nullptr;
+	for (auto& obj : objects_->objects) {
+
+		free_slot(obj->get_handle());
+		delete obj;
+		obj = nullptr;
 	}
 
-	objects_->clear();
+	objects_->objects.clear();
+	objects_->names.clear();
+
+	// every block is back in its pool, drop the slabs together
+	objects_->arena.release();
 }
 
 int ObjectManager::assign_id()
@@ -88,4 +153,33 @@ int ObjectManager::assign_id()
 	return idGenerator_++;
 }
 
-jeEnd
\ No newline at end of file
+ObjectHandle ObjectManager::allocate_slot(Object* object)
+{
+	// no free slot left, grow the table
+	if (freeSlot_ == ObjectHandle::NULL_INDEX) {
+		freeSlot_ = static_cast<unsigned>(slots_.size());
+		slots_.emplace_back();
+	}
+
+	ObjectHandle handle;
+	handle.index = freeSlot_;
+
+	Slot& slot = slots_[freeSlot_];
+	freeSlot_ = slot.next;
+	slot.object = object;
+	handle.generation = slot.generation;
+
+	return handle;
+}
+
+void ObjectManager::free_slot(ObjectHandle handle)
+{
+	// older handles to this slot do not match anymore
+	Slot& slot = slots_[handle.index];
+	slot.object = nullptr;
+	++slot.generation;
+	slot.next = freeSlot_;
+	freeSlot_ = handle.index;
+}
+
+jeEnd
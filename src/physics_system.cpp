@@ -16,101 +16,1201 @@ Contains the methods of PhysicsSystem class
 #include <object.hpp>
 #include <transform.hpp>
 #include <vec3.hpp>
+#include <sat_kernels.hpp>
+#include <job_system.hpp>
 
+#include <cmath>
+#include <cfloat>
+#include <algorithm>
 #include <iostream>
 
 jeBegin
 
 PhysicsSystem::Colliders PhysicsSystem::colliders_;
-PhysicsSystem::Bodies PhysicsSystem::bodies_;
+BodyStore PhysicsSystem::bodies_;
+SweepAndPrune PhysicsSystem::sweepAndPrune_;
+AABBTree PhysicsSystem::dynamicTree_, PhysicsSystem::staticTree_;
+PhysicsSystem::BroadPhase PhysicsSystem::broadPhase = PhysicsSystem::BroadPhase::SWEEP_AND_PRUNE;
+ColliderPairs PhysicsSystem::pairs_;
+std::vector<PhysicsSystem::Contacts> PhysicsSystem::threadContacts_;
+PhysicsSystem::Contacts PhysicsSystem::contacts_;
+ContactCache PhysicsSystem::contactCache_;
+unsigned PhysicsSystem::stepCount_ = 0;
+bool PhysicsSystem::warmStarting = true;
+int PhysicsSystem::iterations = 8;
+int PhysicsSystem::positionIterations = 3;
+std::vector<std::vector<unsigned>> PhysicsSystem::batches_;
+std::vector<ContactManifold> PhysicsSystem::endedContacts_;
+CollisionEvents PhysicsSystem::events_;
+unsigned PhysicsSystem::threadCount = 0;
+float PhysicsSystem::sleepThreshold = 0.001f;
+int PhysicsSystem::stepsToSleep = 60;
+std::vector<float> PhysicsSystem::impacts_;
+std::vector<int> PhysicsSystem::islands_;
+std::vector<unsigned char> PhysicsSystem::islandFlags_;
+PhysicsSystem::Stats PhysicsSystem::stats_;
+float PhysicsSystem::fixedStep = 1.f / 60.f;
+int PhysicsSystem::maxSubSteps = 8;
+float PhysicsSystem::accumulator_ = 0.f, PhysicsSystem::alpha_ = 0.f;
+std::atomic<bool> PhysicsSystem::treesDirty_(false);
+std::mutex PhysicsSystem::refitLock_;
 const int MAX_VERTICES = 64;
 
+// not worth waking a worker for less than this
+const unsigned MIN_PAIRS_PER_THREAD = 256;
+const unsigned MIN_QUERIES_PER_THREAD = 64;
+
+// cached impulse is reused only if the normal turned less than this
+const float WARM_START_COS = 0.9f;
+
+// approaching slower than this per step, the contact is resting
+const float BOUNCE_THRESHOLD = 0.01f;
+
+// contacts beyond the last color share one batch solved on a single thread
+const unsigned MAX_COLORS = 64;
+const unsigned MIN_CONTACTS_PER_THREAD = 128;
+
+// overlap allowed to stay, and the part of the rest solved per iteration
+const float OVERLAP_SLOP = 0.005f;
+const float OVERLAP_RATE = 0.5f;
+
+const unsigned char ISLAND_AWAKE = 0x01;
+const unsigned char ISLAND_RESTLESS = 0x02;
+
 void PhysicsSystem::add_collider(Collider2D* collider)
 {
+	collider->index_ = static_cast<int>(colliders_.size());
 	colliders_.emplace_back(collider);
+	sweepAndPrune_.add(collider);
+	sync_proxy(collider);
 }
 
 void PhysicsSystem::add_rigidbody(RigidBody* rigidbody)
 {
-	bodies_.emplace_back(rigidbody);
+	rigidbody->index_ = bodies_.add(rigidbody);
+	rigidbody->displacement_.set_zero();
+}
+
+void PhysicsSystem::remove_collider(Collider2D* collider)
+{
+	int index = collider->index_;
+	if (index < 0 || index >= static_cast<int>(colliders_.size()) || colliders_[index] != collider)
+		return;
+
+	// the last collider fills the hole
+	colliders_[index] = colliders_.back();
+	colliders_[index]->index_ = index;
+	colliders_.pop_back();
+	collider->index_ = -1;
+
+	sweepAndPrune_.remove(collider);
+
+	// what rested on it has lost its support
+	std::vector<Collider2D*> touching;
+	contactCache_.remove(collider, touching);
+	for (const auto& c : touching)
+	{
+		if (c->body_ >= 0)
+			bodies_.owner[c->body_]->wake_up();
+	}
+
+	// the events are still to be dispatched, drop the ones of this
+	for (auto& e : events_)
+	{
+		if (e.collider == collider || e.other == collider)
+			e.collider = e.other = nullptr;
+	}
+
+	if (collider->proxyId_ != AABBTree::NULL_NODE)
+	{
+		AABBTree& tree = collider->staticProxy_ ? staticTree_ : dynamicTree_;
+		tree.destroy_proxy(collider->proxyId_);
+		collider->proxyId_ = AABBTree::NULL_NODE;
+	}
+}
+
+void PhysicsSystem::remove_rigidbody(RigidBody* rigidbody)
+{
+	int index = rigidbody->index_;
+	if (index < 0 || index >= static_cast<int>(bodies_.size()) || bodies_.owner[index] != rigidbody)
+		return;
+
+	// the body keeps its motion for the next registration
+	rigidbody->displacement_ = bodies_.displacement[index];
+
+	Collider2D* collider = bodies_.collider[index];
+	if (collider)
+	{
+		collider->body_ = -1;
+		collider->static_ = true;
+	}
+
+	bodies_.remove(index);
+	rigidbody->index_ = -1;
+}
+
+const PhysicsSystem::Stats& PhysicsSystem::get_stats()
+{
+	return stats_;
+}
+
+const CollisionEvents& PhysicsSystem::get_collision_events()
+{
+	return events_;
+}
+
+float PhysicsSystem::get_alpha()
+{
+	return alpha_;
 }
 
 void PhysicsSystem::initialize()
 {
+	// on the main thread, the narrow phase workers only read the kernel
+	SATKernels::select_path();
 }
 
 void PhysicsSystem::update(float dt)
 {
-	int size = static_cast<int>(colliders_.size());
-	for (int i = 0; i < size - 1; ++i)
+	accumulator_ += dt;
+	events_.clear();
+
+	// consume the frame time in fixed steps
+	unsigned steps = 0;
+	while (accumulator_ >= fixedStep && static_cast<int>(steps) < maxSubSteps)
 	{
-		for (int j = 0; j < size - i - 1; ++j)
+		step(fixedStep);
+		accumulator_ -= fixedStep;
+		++steps;
+	}
+
+	// too far behind, drop the rest instead of spiraling down
+	if (accumulator_ >= fixedStep)
+		accumulator_ = fmodf(accumulator_, fixedStep);
+
+	// how far the render time is between the last two steps
+	alpha_ = accumulator_ / fixedStep;
+	stats_.steps = steps;
+}
+
+void PhysicsSystem::step(float /*dt*/)
+{
+	sync_bodies();
+	wake_islands();
+
+	// rebuild the world transform of the colliders that have moved
+	for (const auto& c : colliders_)
+	{
+		c->update_transform();
+
+		// fast bodies cover the whole path of the step,
+		// so the narrow phase can find the time of impact
+		int body = c->body_;
+		if (body >= 0 && bodies_.is_bullet(body) && bodies_.is_active(body))
+			c->sweep_bounds(bodies_.displacement[body]);
+		else if (c->swept_)
 		{
-			vec3 N;
-			float t = 1.0f;
+			c->update_bounds();
+			c->swept_ = false;
+		}
+
+		if (broadPhase == BroadPhase::AABB_TREE)
+			sync_proxy(c);
+	}
+
+	// get the candidate pairs from the broad phase
+	if (broadPhase == BroadPhase::AABB_TREE)
+		find_tree_pairs();
+	else
+		sweepAndPrune_.find_pairs(pairs_);
+
+	stats_.colliders = static_cast<unsigned>(colliders_.size());
+	stats_.candidates = static_cast<unsigned>(pairs_.size());
+
+	// every worker only reads the bodies and writes to its own buffer
+	unsigned pairCount = static_cast<unsigned>(pairs_.size());
+	unsigned workers = get_worker_count(pairCount, MIN_PAIRS_PER_THREAD);
+
+	if (threadContacts_.size() < workers)
+		threadContacts_.resize(workers);
 
-			RigidBody* aBody = colliders_[j]->get_owner()->get_component<RigidBody>();
-			RigidBody* bBody = colliders_[j + 1]->get_owner()->get_component<RigidBody>();
+	JobSystem::parallel_for(pairCount, workers, [](unsigned worker, unsigned begin, unsigned end) {
+		find_contacts(begin, end, threadContacts_[worker]);
+	});
 
-			if (is_collided(colliders_[j], colliders_[j + 1], aBody, bBody, N, t))
+	// chunks are in pair order already, sort anyway in case it changes
+	contacts_.clear();
+	for (unsigned i = 0; i < workers; ++i)
+		contacts_.insert(contacts_.end(), threadContacts_[i].begin(), threadContacts_[i].end());
+
+	std::stable_sort(contacts_.begin(), contacts_.end(),
+		[](const Contact& a, const Contact& b) { return a.pair < b.pair; });
+
+	stats_.contacts = static_cast<unsigned>(contacts_.size());
+
+	warm_start();
+	color_contacts();
+	solve_contacts();
+
+	endedContacts_.clear();
+	contactCache_.remove_stale(stepCount_, endedContacts_);
+	for (const auto& m : endedContacts_)
+		events_.push_back({ CollisionEvent::Type::END, m.a, m.b, m.normal });
+
+	stats_.manifolds = contactCache_.size();
+
+	integrate();
+	update_islands();
+	sync_transforms();
+
+	// the bodies have moved, the trees are refit by the next query if any
+	treesDirty_.store(true, std::memory_order_release);
+}
+
+// the state changed out of the step is read once here,
+// the rest of the step works on the store only
+void PhysicsSystem::sync_bodies()
+{
+	unsigned size = bodies_.size();
+	for (unsigned i = 0; i < size; ++i)
+	{
+		RigidBody* body = bodies_.owner[i];
+
+		unsigned char flags = bodies_.flags[i] & BodyStore::ASLEEP;
+		if (body->isStatic) flags |= BodyStore::STATIC;
+		if (body->isBullet) flags |= BodyStore::BULLET;
+
+		bodies_.flags[i] = flags;
+		bodies_.invMass[i] = body->get_invMass();
+
+		if (body->isStatic)
+			bodies_.displacement[i].set_zero();
+
+		// keep the last state for the render interpolation
+		bodies_.position[i] = bodies_.prevPosition[i] = body->transform->position;
+		body->prevOrientation_ = body->transform->orientation;
+
+		Collider2D* collider = bodies_.collider[i];
+		if (collider)
+			collider->static_ = body->isStatic;
+	}
+}
+
+void PhysicsSystem::integrate()
+{
+	unsigned size = bodies_.size();
+	vec3* position = bodies_.position.data();
+	vec3* displacement = bodies_.displacement.data();
+	const unsigned char* flags = bodies_.flags.data();
+
+	// static and sleeping bodies lose their motion, no branch in the loop
+	for (unsigned i = 0; i < size; ++i)
+	{
+		float active = (flags[i] & (BodyStore::STATIC | BodyStore::ASLEEP)) ? 0.f : 1.f;
+		displacement[i] *= active;
+		position[i] += displacement[i];
+	}
+}
+
+void PhysicsSystem::sync_transforms()
+{
+	unsigned size = bodies_.size();
+	for (unsigned i = 0; i < size; ++i)
+	{
+		if (!bodies_.is_static(i))
+			bodies_.owner[i]->transform->position = bodies_.position[i];
+	}
+}
+
+void PhysicsSystem::update_islands()
+{
+	// every dynamic body starts as its own island
+	int size = static_cast<int>(bodies_.size());
+	islands_.resize(size);
+	for (int i = 0; i < size; ++i)
+		islands_[i] = i;
+
+	// touching dynamic bodies share an island
+	for (const auto& c : contacts_)
+		join_islands(c.a, c.b);
+
+	// the sleeping pairs have no contact in the step, their manifolds are kept
+	contactCache_.for_each([](const ContactManifold& m) {
+		if (m.a->body_ >= 0 && m.b->body_ >= 0
+			&& bodies_.is_asleep(m.a->body_) && bodies_.is_asleep(m.b->body_))
+			join_islands(m.a->body_, m.b->body_);
+	});
+
+	// count the resting steps of each awake body
+	float threshold = sleepThreshold * sleepThreshold;
+	for (int i = 0; i < size; ++i)
+	{
+		if (!bodies_.is_active(i))
+			continue;
+
+		if (bodies_.displacement[i].length_sq() < threshold)
+			++bodies_.restSteps[i];
+		else
+			bodies_.restSteps[i] = 0;
+	}
+
+	// an island sleeps when all of its bodies rest long enough,
+	// and wakes as a whole when any of them is awake and not resting
+	islandFlags_.assign(size, 0);
+	for (int i = 0; i < size; ++i)
+	{
+		if (bodies_.is_static(i))
+			continue;
+
+		int root = find_island(i);
+		if (!bodies_.is_asleep(i))
+		{
+			islandFlags_[root] |= ISLAND_AWAKE;
+			if (bodies_.restSteps[i] < stepsToSleep)
+				islandFlags_[root] |= ISLAND_RESTLESS;
+		}
+	}
+
+	stats_.awake = stats_.asleep = 0;
+	for (int i = 0; i < size; ++i)
+	{
+		if (bodies_.is_static(i))
+			continue;
+
+		int root = find_island(i);
+		if (islandFlags_[root] & ISLAND_RESTLESS)
+		{
+			if (bodies_.is_asleep(i))
 			{
-				if (t < 0.f)
-					aBody->process_overlap(bBody, N * -t);
-				else
-					aBody->process_collision(bBody, N, t);
+				bodies_.flags[i] &= ~BodyStore::ASLEEP;
+				bodies_.restSteps[i] = 0;
 			}
 		}
+		else if (islandFlags_[root] & ISLAND_AWAKE)
+		{
+			bodies_.flags[i] |= BodyStore::ASLEEP;
+			bodies_.displacement[i].set_zero();
+		}
+
+		if (bodies_.is_asleep(i))
+			++stats_.asleep;
+		else
+			++stats_.awake;
 	}
+}
+
+void PhysicsSystem::join_islands(int a, int b)
+{
+	if (bodies_.is_static(a) || bodies_.is_static(b))
+		return;
+
+	// the smallest index stays the root, whatever the order of the joins
+	a = find_island(a);
+	b = find_island(b);
+	if (a != b)
+		islands_[a < b ? b : a] = a < b ? a : b;
+}
+
+void PhysicsSystem::wake_islands()
+{
+	// the islands of the last step, a body added or removed since
+	// shifts the indices and the islands are built again at the end
+	int size = static_cast<int>(bodies_.size());
+	if (static_cast<int>(islands_.size()) != size)
+		return;
+
+	// a body woken since the last step wakes its whole island at once
+	islandFlags_.assign(size, 0);
+	for (int i = 0; i < size; ++i)
+	{
+		if (bodies_.is_active(i))
+			islandFlags_[find_island(i)] |= ISLAND_AWAKE;
+	}
+
+	for (int i = 0; i < size; ++i)
+	{
+		if (bodies_.is_asleep(i) && (islandFlags_[find_island(i)] & ISLAND_AWAKE))
+		{
+			bodies_.flags[i] &= ~BodyStore::ASLEEP;
+			bodies_.restSteps[i] = 0;
+		}
+	}
+}
+
+int PhysicsSystem::find_island(int body)
+{
+	// path halving
+	while (islands_[body] != body)
+	{
+		islands_[body] = islands_[islands_[body]];
+		body = islands_[body];
+	}
+
+	return body;
+}
+
+void PhysicsSystem::warm_start()
+{
+	++stepCount_;
+	stats_.warmStarted = 0;
+
+	for (auto& c : contacts_)
+	{
+		const ColliderPair& pair = pairs_[c.pair];
+
+		ContactManifold* manifold;
+		bool cached = contactCache_.find_or_add(pair.a, pair.b, manifold);
 
-	for (const auto& b : bodies_)
+		// the pair can come in the other order than the cached one
+		vec3 normal = manifold->a == pair.a ? c.N : -c.N;
+
+		if (cached && warmStarting && normal.dot(manifold->normal) > WARM_START_COS)
+		{
+			apply_impulse(c.a, c.b, c.N * manifold->normalImpulse);
+			++stats_.warmStarted;
+		}
+		else
+			manifold->normalImpulse = 0.f;
+
+		manifold->normal = normal;
+		manifold->lastStep = stepCount_;
+		c.manifold = manifold;
+
+		events_.push_back({ cached ? CollisionEvent::Type::STAY : CollisionEvent::Type::BEGIN,
+			pair.a, pair.b, c.N });
+	}
+}
+
+// greedy coloring in the contact order, so that no two contacts
+// of the same color write the same dynamic body
+void PhysicsSystem::color_contacts()
+{
+	for (const auto& c : contacts_)
+		bodies_.colorMask[c.a] = bodies_.colorMask[c.b] = 0;
+
+	for (auto& b : batches_)
+		b.clear();
+
+	unsigned colors = 0;
+	for (unsigned i = 0; i < contacts_.size(); ++i)
 	{
-		if (b->isStatic)
+		Contact& c = contacts_[i];
+
+		unsigned long long used = (bodies_.is_static(c.a) ? 0 : bodies_.colorMask[c.a])
+			| (bodies_.is_static(c.b) ? 0 : bodies_.colorMask[c.b]);
+
+		unsigned color = 0;
+		while (color < MAX_COLORS && (used & (1ull << color)))
+			++color;
+
+		if (color < MAX_COLORS)
 		{
-			b->displacement_.set_zero();
+			bodies_.colorMask[c.a] |= 1ull << color;
+			bodies_.colorMask[c.b] |= 1ull << color;
+		}
+
+		c.color = color;
+		if (batches_.size() <= color)
+			batches_.resize(color + 1);
+
+		batches_[color].push_back(i);
+		if (color + 1 > colors)
+			colors = color + 1;
+	}
+
+	stats_.colors = colors;
+}
+
+void PhysicsSystem::solve_contacts()
+{
+	move_to_impact();
+
+	// things done once per contact before the iterations
+	for (auto& c : contacts_)
+	{
+		bodies_.correction[c.a].set_zero();
+		bodies_.correction[c.b].set_zero();
+
+		// bounce back from the speed before the response
+		const RigidBody* body = bodies_.owner[c.a];
+		float n = (bodies_.displacement[c.a] - bodies_.displacement[c.b]).dot(c.N);
+		c.target = n < -BOUNCE_THRESHOLD ? -n * body->restitution : 0.f;
+		c.friction = body->friction;
+		c.glue = body->glue;
+	}
+
+	for (int i = 0; i < iterations; ++i)
+		solve_batches(false);
+
+	for (int i = 0; i < positionIterations; ++i)
+		solve_batches(true);
+
+	for (const auto& c : contacts_)
+	{
+		bodies_.position[c.a] += bodies_.correction[c.a];
+		bodies_.correction[c.a].set_zero();
+
+		bodies_.position[c.b] += bodies_.correction[c.b];
+		bodies_.correction[c.b].set_zero();
+	}
+}
+
+// batches in order, the contacts of a batch in parallel
+void PhysicsSystem::solve_batches(bool position)
+{
+	for (unsigned color = 0; color < batches_.size(); ++color)
+	{
+		const std::vector<unsigned>& batch = batches_[color];
+		unsigned count = static_cast<unsigned>(batch.size());
+		unsigned workers = color < MAX_COLORS ? get_worker_count(count, MIN_CONTACTS_PER_THREAD) : 1;
+
+		JobSystem::parallel_for(count, workers, [&](unsigned, unsigned begin, unsigned end) {
+			for (unsigned i = begin; i < end; ++i)
+			{
+				Contact& c = contacts_[batch[i]];
+
+				if (position)
+				{
+					if (c.t < 0.f)
+						solve_overlap(c);
+				}
+				else
+					solve_collision(c);
+			}
+		});
+	}
+}
+
+// two bodies collided. move the relative displacement along N toward the target
+void PhysicsSystem::solve_collision(Contact& c)
+{
+	float m0 = bodies_.invMass[c.a];
+	float m1 = bodies_.invMass[c.b];
+	float m = m0 + m1;
+
+	if (m <= 0.f)
+		return;
+
+	vec3 D = bodies_.displacement[c.a] - bodies_.displacement[c.b];
+
+	float n = D.dot(c.N);
+
+	vec3 Dn = c.N * n;
+	vec3 Dt = D - Dn;
+
+	// the total normal impulse only pushes, so a warm started
+	// impulse that turned out too strong is partly taken back
+	float& normalImpulse = c.manifold->normalImpulse;
+	float lambda = (c.target - n) / m;
+	float accumulated = normalImpulse + lambda;
+	if (accumulated < 0.f) accumulated = 0.f;
+	lambda = accumulated - normalImpulse;
+	normalImpulse = accumulated;
+
+	float dt = Dt.dot(Dt);
+	float CoF = c.friction;
+
+	if (dt < c.glue * c.glue) CoF = 1.01f;
+
+	apply_impulse(c.a, c.b, c.N * lambda - Dt * (CoF / m));
+}
+
+// two bodies overlapped. push them away from each other
+void PhysicsSystem::solve_overlap(const Contact& c)
+{
+	float m0 = bodies_.invMass[c.a];
+	float m1 = bodies_.invMass[c.b];
+	float m = m0 + m1;
+
+	if (m <= 0.f)
+		return;
+
+	// depth left after the corrections so far
+	float C = -c.t - (bodies_.correction[c.a] - bodies_.correction[c.b]).dot(c.N) - OVERLAP_SLOP;
+	if (C <= 0.f)
+		return;
+
+	vec3 P = c.N * (C * OVERLAP_RATE / m);
+
+	if (!bodies_.is_static(c.a))
+		bodies_.correction[c.a] += P * m0;
+
+	if (!bodies_.is_static(c.b))
+		bodies_.correction[c.b] -= P * m1;
+}
+
+// bullets are moved to the contact first, so they never skip the surface.
+// a body is moved once, to the earliest impact among its contacts
+void PhysicsSystem::move_to_impact()
+{
+	impacts_.assign(bodies_.size(), 1.f);
+
+	bool moved = false;
+	for (const auto& c : contacts_)
+	{
+		if (c.t <= 0.f || !(bodies_.is_bullet(c.a) || bodies_.is_bullet(c.b)))
 			continue;
+
+		int bodies[] = { c.a, c.b };
+		for (int body : bodies)
+		{
+			if (!bodies_.is_static(body) && c.t < impacts_[body])
+				impacts_[body] = c.t;
+		}
+		moved = true;
+	}
+
+	if (!moved)
+		return;
+
+	for (unsigned i = 0; i < impacts_.size(); ++i)
+	{
+		float t = impacts_[i];
+		if (t < 1.f)
+		{
+			bodies_.position[i] += bodies_.displacement[i] * t;
+			bodies_.displacement[i] *= 1.f - t;
 		}
-		
-		b->transform->position += b->displacement_;
+	}
+}
+
+// P is split by the inverse masses, positive to A and negative to B
+void PhysicsSystem::apply_impulse(int a, int b, const vec3& P)
+{
+	// static bodies are shared by the parallel batches, never write them
+	if (!bodies_.is_static(a))
+		bodies_.displacement[a] += P * bodies_.invMass[a];
+
+	if (!bodies_.is_static(b))
+		bodies_.displacement[b] -= P * bodies_.invMass[b];
+}
+
+unsigned PhysicsSystem::get_worker_count(unsigned count, unsigned minPerWorker)
+{
+	unsigned workers = threadCount ? threadCount : JobSystem::get_thread_count();
+	unsigned maxWorkers = count / minPerWorker;
+	if (workers > maxWorkers) workers = maxWorkers;
+	if (workers < 1) workers = 1;
+
+	return workers;
+}
+
+void PhysicsSystem::find_contacts(unsigned begin, unsigned end, Contacts& contacts)
+{
+	contacts.clear();
+
+	for (unsigned i = begin; i < end; ++i)
+	{
+		const ColliderPair& pair = pairs_[i];
+
+		int a = pair.a->body_;
+		int b = pair.b->body_;
+
+		if (a < 0 || b < 0)
+			continue;
+
+		// nothing can move between sleeping or static bodies
+		if (!bodies_.is_active(a) && !bodies_.is_active(b))
+			continue;
+
+		vec3 N;
+		float t = 1.0f;
+
+		if (collide(pair.a, pair.b, bodies_.displacement[a] - bodies_.displacement[b], N, t))
+			contacts.push_back({ i, a, b, N, t, nullptr, 0.f, 0.f, 0.f, 0 });
 	}
 }
 
 void PhysicsSystem::close()
 {
+	for (const auto& c : colliders_)
+	{
+		c->proxyId_ = AABBTree::NULL_NODE;
+		c->index_ = -1;
+		c->body_ = -1;
+		c->static_ = true;
+	}
+
 	colliders_.clear();
 	//colliders_.shrink_to_fit();
 
+	for (const auto& b : bodies_.owner)
+	{
+		b->index_ = -1;
+		b->displacement_.set_zero();
+	}
+
 	bodies_.clear();
 	//bodies_.shrink_to_fit();
+
+	sweepAndPrune_.clear();
+	dynamicTree_.clear();
+	staticTree_.clear();
+	pairs_.clear();
+	threadContacts_.clear();
+	contacts_.clear();
+	contactCache_.clear();
+	batches_.clear();
+	endedContacts_.clear();
+	events_.clear();
+	stepCount_ = 0;
+	impacts_.clear();
+	islands_.clear();
+	islandFlags_.clear();
+	stats_ = Stats();
+	accumulator_ = alpha_ = 0.f;
+	treesDirty_.store(false, std::memory_order_relaxed);
+}
+
+void PhysicsSystem::sync_proxy(Collider2D* collider)
+{
+	int body = collider->body_;
+	bool isStatic = body >= 0 && bodies_.is_static(body);
+
+	// body has been switched between static and dynamic
+	if (collider->proxyId_ != AABBTree::NULL_NODE && collider->staticProxy_ != isStatic)
+	{
+		AABBTree& tree = collider->staticProxy_ ? staticTree_ : dynamicTree_;
+		tree.destroy_proxy(collider->proxyId_);
+		collider->proxyId_ = AABBTree::NULL_NODE;
+	}
+
+	if (collider->proxyId_ == AABBTree::NULL_NODE)
+	{
+		AABBTree& tree = isStatic ? staticTree_ : dynamicTree_;
+		collider->proxyId_ = tree.create_proxy(collider->bounds_, collider);
+		collider->staticProxy_ = isStatic;
+	}
+
+	// static tree is never refit
+	else if (!isStatic)
+		dynamicTree_.move_proxy(collider->proxyId_, collider->bounds_, body >= 0 ? bodies_.displacement[body] : vec3::zero);
+}
+
+bool PhysicsSystem::raycast(const vec3& origin, const vec3& direction, float distance, RaycastHit& hit, unsigned mask)
+{
+	return segment_cast(origin, origin + direction.normalized() * distance, hit, mask);
+}
+
+bool PhysicsSystem::segment_cast(const vec3& from, const vec3& to, RaycastHit& hit, unsigned mask)
+{
+	refit_query_tree();
+	return cast_segment(from, to, hit, mask);
+}
+
+void PhysicsSystem::query_aabb(const AABB& aabb, QueryResult& result, unsigned mask)
+{
+	refit_query_tree();
+	find_overlaps(aabb, result, mask);
+}
+
+void PhysicsSystem::query_point(const vec3& point, QueryResult& result, unsigned mask)
+{
+	refit_query_tree();
+	find_point(point, result, mask);
+}
+
+void PhysicsSystem::segment_cast(const std::vector<Segment>& segments, std::vector<RaycastHit>& hits, unsigned mask)
+{
+	unsigned count = static_cast<unsigned>(segments.size());
+	hits.resize(count);
+	refit_query_tree();
+
+	JobSystem::parallel_for(count, get_worker_count(count, MIN_QUERIES_PER_THREAD),
+		[&](unsigned, unsigned begin, unsigned end) {
+			for (unsigned i = begin; i < end; ++i)
+			{
+				hits[i] = RaycastHit();
+				cast_segment(segments[i].from, segments[i].to, hits[i], mask);
+			}
+		});
+}
+
+void PhysicsSystem::query_aabb(const std::vector<AABB>& aabbs, std::vector<QueryResult>& results, unsigned mask)
+{
+	unsigned count = static_cast<unsigned>(aabbs.size());
+	results.resize(count);
+	refit_query_tree();
+
+	JobSystem::parallel_for(count, get_worker_count(count, MIN_QUERIES_PER_THREAD),
+		[&](unsigned, unsigned begin, unsigned end) {
+			for (unsigned i = begin; i < end; ++i)
+				find_overlaps(aabbs[i], results[i], mask);
+		});
+}
+
+void PhysicsSystem::query_point(const std::vector<vec3>& points, std::vector<QueryResult>& results, unsigned mask)
+{
+	unsigned count = static_cast<unsigned>(points.size());
+	results.resize(count);
+	refit_query_tree();
+
+	JobSystem::parallel_for(count, get_worker_count(count, MIN_QUERIES_PER_THREAD),
+		[&](unsigned, unsigned begin, unsigned end) {
+			for (unsigned i = begin; i < end; ++i)
+				find_point(points[i], results[i], mask);
+		});
+}
+
+// the step moves the proxies before the bodies move, and only with the
+// aabb tree broad phase. the first query after a step brings the trees
+// to the end of the step, the others wait for it and then only read
+void PhysicsSystem::refit_query_tree()
+{
+	if (!treesDirty_.load(std::memory_order_acquire))
+		return;
+
+	std::lock_guard<std::mutex> lock(refitLock_);
+	if (!treesDirty_.load(std::memory_order_relaxed))
+		return;
+
+	for (const auto& c : colliders_)
+	{
+		c->update_transform();
+		sync_proxy(c);
+	}
+
+	treesDirty_.store(false, std::memory_order_release);
+}
+
+bool PhysicsSystem::cast_segment(const vec3& from, const vec3& to, RaycastHit& hit, unsigned mask)
+{
+	bool found = false;
+
+	auto callback = [&](const AABBTree& tree, int proxyId, float maxFraction) {
+		Collider2D* collider = tree.get_collider(proxyId);
+		if (!(collider->category & mask))
+			return maxFraction;
+
+		float fraction;
+		vec3 normal;
+		if (!collider->raycast(from, to, maxFraction, fraction, normal))
+			return maxFraction;
+
+		found = true;
+		hit.collider = collider;
+		hit.fraction = fraction;
+		hit.normal = normal;
+		return fraction;
+	};
+
+	hit.fraction = 1.f;
+	dynamicTree_.raycast(from, to, [&](int proxyId, float maxFraction) {
+		return callback(dynamicTree_, proxyId, maxFraction);
+	});
+
+	// the static tree only looks before the closest dynamic hit
+	staticTree_.raycast(from, to, [&](int proxyId, float maxFraction) {
+		return callback(staticTree_, proxyId, std::min(maxFraction, hit.fraction));
+	});
+
+	if (found)
+		hit.point = from + (to - from) * hit.fraction;
+
+	return found;
+}
+
+void PhysicsSystem::find_overlaps(const AABB& aabb, QueryResult& result, unsigned mask)
+{
+	result.clear();
+
+	auto collect = [&](const AABBTree& tree, int proxyId) {
+		Collider2D* collider = tree.get_collider(proxyId);
+		if ((collider->category & mask) && collider->bounds_.overlaps(aabb))
+			result.push_back(collider);
+		return true;
+	};
+
+	dynamicTree_.query(aabb, [&](int proxyId) { return collect(dynamicTree_, proxyId); });
+	staticTree_.query(aabb, [&](int proxyId) { return collect(staticTree_, proxyId); });
+}
+
+void PhysicsSystem::find_point(const vec3& point, QueryResult& result, unsigned mask)
+{
+	result.clear();
+
+	AABB aabb;
+	aabb.min = aabb.max = point;
+
+	auto collect = [&](const AABBTree& tree, int proxyId) {
+		Collider2D* collider = tree.get_collider(proxyId);
+		if ((collider->category & mask) && collider->test_point(point))
+			result.push_back(collider);
+		return true;
+	};
+
+	dynamicTree_.query(aabb, [&](int proxyId) { return collect(dynamicTree_, proxyId); });
+	staticTree_.query(aabb, [&](int proxyId) { return collect(staticTree_, proxyId); });
+}
+
+void PhysicsSystem::find_tree_pairs()
+{
+	pairs_.clear();
+
+	// only the moving colliders look for pairs,
+	// static colliders never meet each other
+	for (const auto& c : colliders_)
+	{
+		if (c->proxyId_ == AABBTree::NULL_NODE || c->staticProxy_)
+			continue;
+
+		const AABB& bounds = c->bounds_;
+
+		// each dynamic pair is reported once, by the lower proxy id
+		dynamicTree_.query(bounds, [&](int proxyId) {
+			Collider2D* other = dynamicTree_.get_collider(proxyId);
+			if (proxyId > c->proxyId_ && c->can_collide(other) && other->bounds_.overlaps(bounds))
+				pairs_.push_back({ c, other });
+			return true;
+		});
+
+		staticTree_.query(bounds, [&](int proxyId) {
+			Collider2D* other = staticTree_.get_collider(proxyId);
+			if (c->can_collide(other) && other->bounds_.overlaps(bounds))
+				pairs_.push_back({ c, other });
+			return true;
+		});
+	}
 }
 
 bool PhysicsSystem::is_collided(Collider2D* a, Collider2D* b, RigidBody* aBody, RigidBody* bBody, vec3& N, float& t)
 {
-	if (!aBody->isStatic)
-		a->init_vertices();
+	return collide(a, b, aBody->get_displacement() - bBody->get_displacement(), N, t);
+}
+
+bool PhysicsSystem::collide(Collider2D* a, Collider2D* b, const vec3& displacement, vec3& N, float& t)
+{
+	// dispatch by the shape pair
+	if (a->is_circle())
+	{
+		if (b->is_circle())
+			return circle_circle(a, b, displacement, N, t);
+
+		return circle_polygon(a, b, displacement, N, t);
+	}
+
+	if (b->is_circle())
+	{
+		// solved from the circle side, so flip the normal back
+		if (!circle_polygon(b, a, -displacement, N, t))
+			return false;
+
+		N = -N;
+		return true;
+	}
+
+	return polygon_polygon(a, b, displacement, N, t);
+}
+
+bool PhysicsSystem::circle_circle(Collider2D* a, Collider2D* b, const vec3& displacement, vec3& N, float& t)
+{
+	float radius = a->radius_ + b->radius_;
+	if (a->radius_ <= 0.f || b->radius_ <= 0.f)
+		return false;
+
+	vec3 relPos = a->position_ - b->position_;
+	vec3 relDis = displacement;
+	relPos.z = relDis.z = 0.f;
+
+	float c = relPos.dot(relPos) - radius * radius;
+
+	// overlapped, push along the line of the centers
+	if (c < 0.f)
+	{
+		float distance = relPos.length();
+		if (distance > 0.000001f)
+			N = relPos / distance;
+		else
+			N.set(1.f, 0.f, 0.f);
+
+		t = distance - radius;
+		return true;
+	}
+
+	// solve |relPos + relDis * t| = radius for the first root
+	float dd = relDis.dot(relDis);
+	float pd = relPos.dot(relDis);
+
+	if (dd < 0.000001f || pd >= 0.f)
+		return false;
+
+	float discriminant = pd * pd - dd * c;
+	if (discriminant < 0.f)
+		return false;
+
+	float toi = (-pd - sqrtf(discriminant)) / dd;
+	if (toi < 0.f || toi > t)
+		return false;
+
+	N = (relPos + relDis * toi).normalized();
+	t = toi;
+	return true;
+}
+
+bool PhysicsSystem::circle_polygon(Collider2D* a, Collider2D* b, const vec3& displacement, vec3& N, float& t)
+{
+	const vec3* vertices = b->vertices_;
+	int size = b->vertexCount_;
+	float radius = a->radius_;
+
+	if (radius <= 0.f || size < 2)
+		return false;
+
+	// circle center and motion in the local space of the polygon
+	mat3 bTransposed = b->rotation_.transposed();
+	vec3 center = bTransposed * (a->position_ - b->position_);
+	vec3 relDis = bTransposed * displacement;
+	center.z = relDis.z = 0.f;
+
+	vec3 normals[MAX_VERTICES];
+	b->get_normals(normals);
+
+	// edge with the largest separation from the center
+	int edge = 0;
+	float separation = -FLT_MAX;
+	for (int i = 0; i < size; ++i)
+	{
+		float s = normals[i].dot(center - vertices[i]);
+		if (s > separation)
+		{
+			separation = s;
+			edge = i;
+		}
+	}
+
+	if (separation <= radius)
+	{
+		const vec3& v1 = vertices[edge];
+		const vec3& v2 = vertices[(edge + 1) % size];
+
+		vec3 local;
+		float depth = 0.f;
+		bool overlapped = false;
+
+		// center inside of the polygon
+		if (separation < 0.000001f)
+		{
+			local = normals[edge];
+			depth = radius - separation;
+			overlapped = true;
+		}
+		else
+		{
+			// closest feature is one of the vertices or the face
+			vec3 closest;
+			if ((center - v1).dot(v2 - v1) <= 0.f)
+				closest = v1;
+			else if ((center - v2).dot(v1 - v2) <= 0.f)
+				closest = v2;
+			else
+				closest = center - normals[edge] * separation;
+
+			vec3 toCenter = center - closest;
+			float distance = toCenter.length();
+			if (distance < radius)
+			{
+				local = distance > 0.000001f ? toCenter / distance : normals[edge];
+				depth = radius - distance;
+				overlapped = true;
+			}
+		}
+
+		if (overlapped)
+		{
+			N = b->rotation_ * local;
+			t = -depth;
+			return true;
+		}
+	}
+
+	// sweep the center against the polygon inflated by the radius
+	if (relDis.dot(relDis) < 0.000001f)
+		return false;
+
+	float toi = t;
+	vec3 local;
+	bool hit = false;
 
-	if (!bBody->isStatic)
-		b->init_vertices();
+	for (int i = 0; i < size; ++i)
+	{
+		const vec3& v1 = vertices[i];
+		const vec3& v2 = vertices[(i + 1) % size];
+
+		// face pushed out by the radius
+		float approach = relDis.dot(normals[i]);
+		if (approach < 0.f)
+		{
+			float s = (center - v1).dot(normals[i]) - radius;
+			float toiEdge = -s / approach;
+
+			if (toiEdge >= 0.f && toiEdge <= toi)
+			{
+				vec3 p = center + relDis * toiEdge - v1;
+				vec3 E = v2 - v1;
+				float u = p.dot(E);
+				if (u >= 0.f && u <= E.dot(E))
+				{
+					toi = toiEdge;
+					local = normals[i];
+					hit = true;
+				}
+			}
+		}
 
-	const std::vector<vec3>& aVertices = a->vertices_;
-	const std::vector<vec3>& bVertices = b->vertices_;
+		// rounded corner
+		vec3 m = center - v1;
+		float dd = relDis.dot(relDis);
+		float pd = m.dot(relDis);
+		float c = m.dot(m) - radius * radius;
+		float discriminant = pd * pd - dd * c;
 
-	int aSize = static_cast<int>(aVertices.size());
-	int bSize = static_cast<int>(bVertices.size());
+		if (pd < 0.f && discriminant >= 0.f)
+		{
+			float toiVertex = (-pd - sqrtf(discriminant)) / dd;
+			if (toiVertex >= 0.f && toiVertex <= toi)
+			{
+				toi = toiVertex;
+				local = (m + relDis * toiVertex).normalized();
+				hit = true;
+			}
+		}
+	}
+
+	if (!hit)
+		return false;
+
+	N = b->rotation_ * local;
+	t = toi;
+	return true;
+}
+
+bool PhysicsSystem::polygon_polygon(Collider2D* a, Collider2D* b, const vec3& displacement, vec3& N, float& t)
+{
+	// local space vertices cached by the colliders
+	const vec3* aVertices = a->vertices_;
+	const vec3* bVertices = b->vertices_;
+
+	int aSize = a->vertexCount_;
+	int bSize = b->vertexCount_;
 
 	if (!aSize || !bSize) return false;
 
-	const vec3& aPos = a->transform->position;
-	const vec3& bPos = b->transform->position;
-	const vec3& aDis = aBody->displacement_;
-	const vec3& bDis = bBody->displacement_;
-	mat3 aOrientation = a->transform->orientation.to_mat3(), bOrientation = b->transform->orientation.to_mat3();
+	// world transform cached by the colliders at the beginning of the step
+	const vec3& aPos = a->position_;
+	const vec3& bPos = b->position_;
+	const mat3& aOrientation = a->rotation_;
+	const mat3& bOrientation = b->rotation_;
 
-	mat3 aTransposed = aOrientation.transposed();
 	mat3 bTransposed = bOrientation.transposed();
 
+	// everything below is in the local space of B
 	vec3 relPos = bTransposed * (aPos - bPos);
-	vec3 relDis = bTransposed * (aDis - bDis);
-	mat3 relOrient = bTransposed * aTransposed;
+	vec3 relDis = bTransposed * displacement;
+	mat3 relOrient = bTransposed * aOrientation;
+
+	vec3 aLocal[MAX_VERTICES];
+	for (int i = 0; i < aSize; ++i)
+		aLocal[i] = relOrient * aVertices[i];
 
 	// All the separation axes
 	vec3 xAxis[MAX_VERTICES]; // note : a maximum of 32 vertices per poly is supported
@@ -119,68 +1219,49 @@ bool PhysicsSystem::is_collided(Collider2D* a, Collider2D* b, RigidBody* aBody,
 	float fVel2 = relDis.dot(relDis);
 
 	if (fVel2 > 0.000001f)
-	{
-		if (!interval_intersect(aVertices, bVertices, xAxis[iAxes], relPos, relDis, relOrient, tAxis[iAxes], t))
-		{
-			return false;
-		}
-		iAxes++;
-	}
+		xAxis[iAxes++] = vec3(-relDis.y, relDis.x, 0.f);
 
-	// test separation axes of A
+	// separation axes of A
 	for (int j = aSize - 1, i = 0; i < aSize; j = i, i++)
 	{
-		vec3 E0 = aVertices[j];
-		vec3 E1 = aVertices[i];
-		vec3 E = E1 - E0;
-		xAxis[iAxes] = relOrient * vec3(-E.y, E.x, 0.f);
-
-		if (!interval_intersect(aVertices, bVertices, xAxis[iAxes], relPos, relDis, relOrient, tAxis[iAxes], t))
-			return false;
-
-		iAxes++;
+		vec3 E = aVertices[i] - aVertices[j];
+		xAxis[iAxes++] = relOrient * vec3(-E.y, E.x, 0.f);
 	}
 
-	// test separation axes of B
+	// separation axes of B
 	for (int j = bSize - 1, i = 0; i < bSize; j = i, i++)
 	{
-		vec3 E0 = bVertices[j];
-		vec3 E1 = bVertices[i];
-		vec3 E = E1 - E0;
-		xAxis[iAxes] = vec3(-E.y, E.x, 0.f);
-
-		if (!interval_intersect(aVertices, bVertices, xAxis[iAxes], relPos, relDis, relOrient, tAxis[iAxes], t))
-			return false;
-
-		iAxes++;
+		vec3 E = bVertices[i] - bVertices[j];
+		xAxis[iAxes++] = vec3(-E.y, E.x, 0.f);
 	}
 
 	// special case for segments
 	if (bSize == 2)
-	{
-		vec3 E = bVertices[1] - bVertices[0];
-		xAxis[iAxes] = E;
+		xAxis[iAxes++] = bVertices[1] - bVertices[0];
 
-		if (!interval_intersect(aVertices, bVertices, xAxis[iAxes], relPos, relDis, relOrient, tAxis[iAxes], t))
-		{
-			return false;
-		}
+	if (aSize == 2)
+		xAxis[iAxes++] = relOrient * (aVertices[1] - aVertices[0]);
 
-		iAxes++;
-	}
+	// project both polygons onto every axis at once,
+	// the padding lanes are computed and thrown away
+	const int PADDED = MAX_VERTICES + SATKernels::LANES;
+	float axisX[PADDED], axisY[PADDED];
+	float aMin[PADDED], aMax[PADDED], bMin[PADDED], bMax[PADDED];
 
-	// special case for segments
-	if (aSize == 2)
+	int padded = (iAxes + SATKernels::LANES - 1) / SATKernels::LANES * SATKernels::LANES;
+	for (int i = 0; i < padded; ++i)
 	{
-		vec3 E = aVertices[1] - aVertices[0];
-		xAxis[iAxes] = relOrient * E;
+		axisX[i] = i < iAxes ? xAxis[i].x : 0.f;
+		axisY[i] = i < iAxes ? xAxis[i].y : 0.f;
+	}
 
-		if (!interval_intersect(aVertices, bVertices, xAxis[iAxes], relPos, relDis, relOrient, tAxis[iAxes], t))
-		{
-			return false;
-		}
+	SATKernels::project(aLocal, aSize, axisX, axisY, iAxes, aMin, aMax);
+	SATKernels::project(bVertices, bSize, axisX, axisY, iAxes, bMin, bMax);
 
-		iAxes++;
+	for (int i = 0; i < iAxes; ++i)
+	{
+		if (!interval_intersect(aMin[i], aMax[i], bMin[i], bMax[i], xAxis[i], relPos, relDis, tAxis[i], t))
+			return false;
 	}
 
 	if (!find_MTD(xAxis, tAxis, iAxes, N, t))
@@ -190,20 +1271,16 @@ bool PhysicsSystem::is_collided(Collider2D* a, Collider2D* b, RigidBody* aBody,
 	if (N.dot(relPos) < 0.0f)
 		N = -N;
 	
-	N = relOrient * N;
+	// back to world space
+	N = bOrientation * N;
 
 	return true;
 }
 
-bool PhysicsSystem::interval_intersect(const std::vector<vec3>& A, const std::vector<vec3>& B,
-	const vec3& xAxis, const vec3& xOffset, const vec3& xVel, 
-	const mat3& xOrient, float& tAxis, const float tMax)
+// min0 and max0 are the interval of A relative to its own position
+bool PhysicsSystem::interval_intersect(float min0, float max0, float min1, float max1,
+	const vec3& xAxis, const vec3& xOffset, const vec3& xVel, float& tAxis, const float tMax)
 {
-	float min0, max0;
-	float min1, max1;
-	get_interval(A, xOrient.transposed() * xAxis, min0, max0);
-	get_interval(B, xAxis, min1, max1);
-
 	float h = xOffset.dot(xAxis);
 	min0 += h;
 	max0 += h;
@@ -239,23 +1316,6 @@ bool PhysicsSystem::interval_intersect(const std::vector<vec3>& A, const std::ve
 	}
 }
 
-// calculate the projection range of a polygon along an axis
-void PhysicsSystem::get_interval(const std::vector<vec3>& vertices, const vec3& xAxis, float& min, float& max)
-{
-	int size = static_cast<int>(vertices.size());
-	min = max = vertices[0].dot(xAxis);
-
-	for (int i = 1; i < size; i++)
-	{
-		float d = vertices[i].dot(xAxis);
-
-		if (d < min) 
-			min = d; 
-		else if (d > max) 
-			max = d;
-	}
-}
-
 bool PhysicsSystem::find_MTD(vec3* xAxis, float* taxis, int iAxes, vec3& N, float& t)
 {
 	// nope, find overlaps
@@ -291,7 +1351,7 @@ bool PhysicsSystem::find_MTD(vec3* xAxis, float* taxis, int iAxes, vec3& N, floa
 		{
 			mini = i;
 			t = taxis[i];
-			N = xAxis[i];
+			N = xAxis[i] / n;
 		}
 	}
 
@@ -8,13 +8,10 @@
 #include <colors.hpp>
 #include <math_util.hpp>
 #include <transform.hpp>
+#include <rigidbody.hpp>
 #include <input_handler.hpp>
 
-#include <sprite.hpp>
-#include <model.hpp>
-#include <text.hpp>
 #include <light.hpp>
-#include <emitter.hpp>
 
 #include <glew.h>
 
@@ -91,37 +88,34 @@ bool Renderer::picked() const
 	return in1 || in2;
 }
 
-void Renderer::set_parent_renderer()
+vec3 Renderer::get_render_position() const
 {
-	Object* parentObject = get_owner()->get_parent();
-	if (parentObject)
-	{
-		if (parentObject->has_component<Sprite>())
-		{
-			parent_ = parentObject->get_component<Sprite>();
-			return;
-		}
-		else if (parentObject->has_component<Text>())
-		{
-			parent_ = parentObject->get_component<Text>();
-			return;
-		}
-		else if (parentObject->has_component<Emitter>())
-		{
-			parent_ = parentObject->get_component<Emitter>();
-			return;
-		}
-		else if (parentObject->has_component<Light>())
-		{
-			parent_ = parentObject->get_component<Light>();
-			return;
-		}
-		else if (parentObject->has_component<Model>())
-		{
-			parent_ = parentObject->get_component<Model>();
-			return;
-		}
-	}
+	return body_ ? body_->get_interpolated_position() : transform_->position;
+}
+
+quat Renderer::get_render_orientation() const
+{
+	return body_ ? body_->get_interpolated_orientation() : transform_->orientation;
+}
+
+mat4 Renderer::get_render_matrix() const
+{
+	if (!body_)
+		return transform_->get_world_matrix();
+
+	// between the last two physics steps, under the cached matrix of the parent
+	mat4 local = Transform::compose(body_->get_interpolated_position(),
+		body_->get_interpolated_orientation(), transform_->scale);
+
+	Transform* parent = transform_->get_parent();
+	return parent ? parent->get_world_matrix() * local : local;
+}
+
+void Renderer::find_body()
+{
+	// the physics body to interpolate the drawn transform with
+	body_ = get_owner()->has_component<RigidBody>()
+		? get_owner()->get_component<RigidBody>() : nullptr;
 }
 
 jeEnd
\ No newline at end of file
@@ -1,7 +1,9 @@
 #include <physics_system.hpp>
 #include <rigidbody.hpp>
+#include <collider_2d.hpp>
 #include <transform.hpp>
 #include <object.hpp>
+#include <debug_tools.hpp>
 
 jeBegin
 
@@ -12,77 +14,115 @@ RigidBody::RigidBody(Object* owner)
 mass_(1.f), displacement_(vec3(0.f, 0.f, 0.f)) 
 {}
 
-RigidBody::~RigidBody() {}
+RigidBody::~RigidBody()
+{
+	remove_from_system();
+}
 
 void RigidBody::add_to_system()
 {
+	DEBUG_ASSERT(!get_owner()->has_parent(), "RigidBody on a child object!");
 	transform = get_owner()->get_component<Transform>();
+	prevOrientation_ = transform->orientation;
+
 	PhysicsSystem::add_rigidbody(this);
+
+	// the collider refers to this by the index in the store
+	if (get_owner()->has_component<Collider2D>())
+	{
+		Collider2D* collider = get_owner()->get_component<Collider2D>();
+		if (collider)
+		{
+			collider->body_ = index_;
+			collider->static_ = isStatic;
+			PhysicsSystem::bodies_.collider[index_] = collider;
+		}
+	}
 }
 
-void RigidBody::remove_from_system() {}
+void RigidBody::remove_from_system()
+{
+	PhysicsSystem::remove_rigidbody(this);
+}
 
-void RigidBody::add_impulse(const vec3& force, float dt)
+void RigidBody::add_impulse(const vec3& force, float dt, bool wake)
 {
 	if (isStatic) 
 		return;
 
-	displacement_ += force * (mass_ * dt * dt);
-}
+	vec3 impulse = force * (mass_ * dt * dt);
 
-float RigidBody::get_invMass() const
-{
-	return (1.f / mass_);
-}
+	// not registered yet, handed to the store on the registration
+	if (index_ < 0)
+	{
+		displacement_ += impulse;
+		return;
+	}
 
-// two objects collided at time t. stop them at that time
-void RigidBody::process_collision(RigidBody* other, const vec3& N, float t)
-{
-	vec3 D = displacement_ - other->displacement_;
+	BodyStore& bodies = PhysicsSystem::bodies_;
+	if (bodies.is_asleep(index_))
+	{
+		if (!wake)
+			return;
 
-	float n = D.dot(N);
+		wake_up();
+	}
 
-	vec3 Dn = N * n;
-	vec3 Dt = D - Dn;
+	bodies.displacement[index_] += impulse;
+}
 
-	if (n > 0.0f)
-		Dn.set_zero();
+void RigidBody::wake_up()
+{
+	if (index_ < 0)
+		return;
 
-	float dt = Dt.dot(Dt);
-	float CoF = friction;
+	BodyStore& bodies = PhysicsSystem::bodies_;
+	bodies.flags[index_] &= ~BodyStore::ASLEEP;
+	bodies.restSteps[index_] = 0;
+}
 
-	if (dt < glue * glue) CoF = 1.01f;
+bool RigidBody::is_awake() const
+{
+	return index_ < 0 || !PhysicsSystem::bodies_.is_asleep(index_);
+}
 
-	D = (Dn * -(1.0f + restitution)) - (Dt * CoF);
+vec3 RigidBody::get_displacement() const
+{
+	return index_ < 0 ? displacement_ : PhysicsSystem::bodies_.displacement[index_];
+}
 
-	float m0 = get_invMass();
-	float m1 = other->get_invMass();
-	float m = m0 + m1;
-	float r0 = m0 / m;
-	float r1 = m1 / m;
+float RigidBody::get_invMass() const
+{
+	// static bodies do not take any response
+	return isStatic ? 0.f : (1.f / mass_);
+}
 
-	displacement_ += D * r0;
-	other->displacement_ -= D * r1;
+vec3 RigidBody::get_interpolated_position() const
+{
+	if (isStatic || index_ < 0)
+		return transform->position;
+
+	float alpha = PhysicsSystem::get_alpha();
+	return PhysicsSystem::bodies_.prevPosition[index_] * (1.f - alpha) + transform->position * alpha;
 }
 
-// two objects overlapped. push them away from each other
-void RigidBody::process_overlap(RigidBody* other, const vec3& xMTD)
+quat RigidBody::get_interpolated_orientation() const
 {
-	if (isStatic && !other->isStatic)
-	{
-		other->transform->position -= xMTD;
-	}
-	else if (!isStatic && other->isStatic)
-	{
-		transform->position += xMTD;
-	}
-	else if (!isStatic && !other->isStatic)
-	{
-		transform->position += xMTD * 0.5f;
-		other->transform->position -= xMTD * 0.5f;
-	}
+	if (isStatic || index_ < 0)
+		return transform->orientation;
+
+	float alpha = PhysicsSystem::get_alpha();
+	const quat& to = transform->orientation;
+
+	// take the shorter arc
+	float beta = prevOrientation_.dot(to) < 0.f ? -alpha : alpha;
+	const quat& from = prevOrientation_;
 
-	process_collision(other, xMTD.normalized(), 0.0f);
+	quat q(from.x * (1.f - alpha) + to.x * beta,
+		from.y * (1.f - alpha) + to.y * beta,
+		from.z * (1.f - alpha) + to.z * beta,
+		from.w * (1.f - alpha) + to.w * beta);
+	return q.normalized();
 }
 
 jeEnd
\ No newline at end of file
@@ -0,0 +1,187 @@
+/******************************************************************************/
+/*!
+\file   sat_kernels.cpp
+\author Jeong Juyong
+\par    email: jaykop.jy\@gmail.com
+\date   2026/10/17(yy/mm/dd)
+
+\description
+Contains the methods of SATKernels class
+*/
+/******************************************************************************/
+
+#include <sat_kernels.hpp>
+#include <vec3.hpp>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define jeSATx86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// msvc takes the avx intrinsics anywhere, gcc and clang need the function marked
+#if defined(jeSATx86) && !defined(_MSC_VER)
+#define jeTargetAVX __attribute__((target("avx")))
+#define jeTargetSSE __attribute__((target("sse2")))
+#else
+#define jeTargetAVX
+#define jeTargetSSE
+#endif
+
+jeBegin
+
+SATKernels::Kernel SATKernels::kernel_ = &SATKernels::project_scalar;
+SATKernels::Path SATKernels::path_ = SATKernels::Path::SCALAR;
+
+SATKernels::Path SATKernels::get_path()
+{
+	return path_;
+}
+
+bool SATKernels::is_supported(Path path)
+{
+	if (path == Path::SCALAR)
+		return true;
+
+#if defined(jeSATx86) && defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 1);
+
+	if (path == Path::SSE)
+		return (info[3] & (1 << 26)) != 0;
+
+	// the os has to save the ymm registers too
+	bool osxsave = (info[2] & (1 << 27)) != 0;
+	bool avx = (info[2] & (1 << 28)) != 0;
+	return osxsave && avx && (_xgetbv(0) & 0x6) == 0x6;
+#elif defined(jeSATx86)
+	__builtin_cpu_init();
+	return path == Path::SSE ? __builtin_cpu_supports("sse2") != 0
+		: __builtin_cpu_supports("avx") != 0;
+#else
+	return false;
+#endif
+}
+
+void SATKernels::set_path(Path path)
+{
+	if (!is_supported(path))
+		return;
+
+	path_ = path;
+	switch (path)
+	{
+	case Path::AVX:
+		kernel_ = &project_avx;
+		break;
+	case Path::SSE:
+		kernel_ = &project_sse;
+		break;
+	default:
+		kernel_ = &project_scalar;
+		break;
+	}
+}
+
+void SATKernels::select_path()
+{
+	if (is_supported(Path::AVX))
+		set_path(Path::AVX);
+	else if (is_supported(Path::SSE))
+		set_path(Path::SSE);
+	else
+		set_path(Path::SCALAR);
+}
+
+void SATKernels::project(const vec3* vertices, int vertexCount,
+	const float* axisX, const float* axisY, int axisCount, float* min, float* max)
+{
+	kernel_(vertices, vertexCount, axisX, axisY, axisCount, min, max);
+}
+
+void SATKernels::project_scalar(const vec3* vertices, int vertexCount,
+	const float* axisX, const float* axisY, int axisCount, float* min, float* max)
+{
+	for (int a = 0; a < axisCount; ++a)
+	{
+		float d = vertices[0].x * axisX[a] + vertices[0].y * axisY[a];
+		float lo = d, hi = d;
+
+		for (int v = 1; v < vertexCount; ++v)
+		{
+			d = vertices[v].x * axisX[a] + vertices[v].y * axisY[a];
+			lo = d < lo ? d : lo;
+			hi = d > hi ? d : hi;
+		}
+
+		min[a] = lo;
+		max[a] = hi;
+	}
+}
+
+// four axes per block, every vertex is broadcast over the lanes
+jeTargetSSE void SATKernels::project_sse(const vec3* vertices, int vertexCount,
+	const float* axisX, const float* axisY, int axisCount, float* min, float* max)
+{
+#if defined(jeSATx86)
+	for (int a = 0; a < axisCount; a += 4)
+	{
+		__m128 x = _mm_loadu_ps(axisX + a);
+		__m128 y = _mm_loadu_ps(axisY + a);
+
+		__m128 d = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(vertices[0].x), x),
+			_mm_mul_ps(_mm_set1_ps(vertices[0].y), y));
+		__m128 lo = d, hi = d;
+
+		for (int v = 1; v < vertexCount; ++v)
+		{
+			d = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(vertices[v].x), x),
+				_mm_mul_ps(_mm_set1_ps(vertices[v].y), y));
+			lo = _mm_min_ps(lo, d);
+			hi = _mm_max_ps(hi, d);
+		}
+
+		_mm_storeu_ps(min + a, lo);
+		_mm_storeu_ps(max + a, hi);
+	}
+#else
+	project_scalar(vertices, vertexCount, axisX, axisY, axisCount, min, max);
+#endif
+}
+
+// eight axes per block
+jeTargetAVX void SATKernels::project_avx(const vec3* vertices, int vertexCount,
+	const float* axisX, const float* axisY, int axisCount, float* min, float* max)
+{
+#if defined(jeSATx86)
+	for (int a = 0; a < axisCount; a += 8)
+	{
+		__m256 x = _mm256_loadu_ps(axisX + a);
+		__m256 y = _mm256_loadu_ps(axisY + a);
+
+		__m256 d = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(vertices[0].x), x),
+			_mm256_mul_ps(_mm256_set1_ps(vertices[0].y), y));
+		__m256 lo = d, hi = d;
+
+		for (int v = 1; v < vertexCount; ++v)
+		{
+			d = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(vertices[v].x), x),
+				_mm256_mul_ps(_mm256_set1_ps(vertices[v].y), y));
+			lo = _mm256_min_ps(lo, d);
+			hi = _mm256_max_ps(hi, d);
+		}
+
+		_mm256_storeu_ps(min + a, lo);
+		_mm256_storeu_ps(max + a, hi);
+	}
+
+	// no penalty on the way back to the sse code
+	_mm256_zeroupper();
+#else
+	project_scalar(vertices, vertexCount, axisX, axisY, axisCount, min, max);
+#endif
+}
+
+jeEnd
@@ -13,15 +13,29 @@ Contains the methods of scene class
 #include <scene.hpp>
 #include <object.hpp>
 #include <object_manager.hpp>
+#include <command_buffer.hpp>
 #include <asset_manager.hpp>
+#include <system_scheduler.hpp>
 
 #include <sound_system.hpp>
 #include <physics_system.hpp>
 #include <graphic_system.hpp>
 #include <behavior_system.hpp>
+#include <transform_system.hpp>
 
 #include <text.hpp>
 #include <mesh.hpp>
+#include <audio.hpp>
+#include <light.hpp>
+#include <model.hpp>
+#include <camera.hpp>
+#include <sprite.hpp>
+#include <emitter.hpp>
+#include <behavior.hpp>
+#include <transform.hpp>
+#include <rigidbody.hpp>
+#include <collider_2d.hpp>
+#include <animation_2d.hpp>
 
 #include <glew.h>
 
@@ -102,23 +116,61 @@ void Scene::initialize()
 	GraphicSystem::initialize();
 	PhysicsSystem::initialize();
 	SoundSystem::initialize();
+	TransformSystem::initialize();
+
+	add_systems();
 }
 
 void Scene::update(float dt)
 {
 	// update all systems
-	BehaviorSystem::update(dt);
-	SoundSystem::update(dt);
-	PhysicsSystem::update(dt);
-	GraphicSystem::update(dt);
+	SystemScheduler::update(dt);
 }
 
 void Scene::close()
 {
+	SystemScheduler::clear();
+
 	BehaviorSystem::close();
 	SoundSystem::close();
 	PhysicsSystem::close();
 	GraphicSystem::close();
+	TransformSystem::close();
+}
+
+void Scene::add_systems()
+{
+	// the scripts may move the bodies and play the sounds.
+	// they also touch GL and the SDL window, so they stay on the main thread
+	SystemScheduler::add_system("Behavior", &BehaviorSystem::update)
+		.on_main_thread()
+		.write<Behavior>().write<Transform>().write<RigidBody>().write<Audio>();
+
+	// overlaps the physics once the behaviors are done
+	SystemScheduler::add_system("Sound", &SoundSystem::update)
+		.write<Audio>();
+
+	SystemScheduler::add_system("Physics", &PhysicsSystem::update)
+		.write<Transform>().write<RigidBody>().write<Collider2D>();
+
+	SystemScheduler::add_system("Collision", [](float) {
+		BehaviorSystem::dispatch_collisions(PhysicsSystem::get_collision_events()); })
+		.after("Physics")
+		.on_main_thread()
+		.write<Behavior>().write<Transform>().write<RigidBody>().write<Audio>();
+
+	// sync point, the spawns and despawns of this frame take effect
+	SystemScheduler::add_system("Command", [](float) { CommandBuffer::play_back(); })
+		.exclusive();
+
+	// the world matrices of what has moved, before they are drawn
+	SystemScheduler::add_system("Transform", &TransformSystem::update)
+		.write<Transform>();
+
+	SystemScheduler::add_system("Graphic", &GraphicSystem::update)
+		.on_main_thread()
+		.read<Transform>().read<Sprite>().read<Text>().read<Model>()
+		.write<Camera>().write<Light>().write<Emitter>().write<Animation2D>();
 }
 
 void Scene::unload()
@@ -161,6 +213,7 @@ void Scene::unload()
 	archetypes_.clear();
 
 	// make sure current object map belongs to the current scene
+	CommandBuffer::clear();
 	ObjectManager::objects_ = &objects_;
 	ObjectManager::clear_objects();
 	ObjectManager::objects_ = nullptr;
@@ -172,14 +225,20 @@ void Scene::resume()
 	//SoundSystem::resume();
 	//PhysicsSystem::resume();
 	GraphicSystem::resume();
+	TransformSystem::resume();
+
+	add_systems();
 }
 
 void Scene::pause()
 {
+	SystemScheduler::clear();
+
 	BehaviorSystem::pause();
 	//SoundSystem::pause();
 	//PhysicsSystem::pause();
 	GraphicSystem::pause();
+	TransformSystem::pause();
 }
 
 const char* Scene::get_name() const
@@ -189,11 +248,9 @@ const char* Scene::get_name() const
 
 void Scene::register_object(Object* obj) {
 
-	// check if the object is pointing null
-	if (ObjectManager::objects_) {
-		ObjectManager::objects_->insert({ obj->get_name(), obj });
+	// the object is already in the map since it was created
+	if (ObjectManager::objects_)
 		obj->register_components();
-	}
 }
 
 jeEnd
\ No newline at end of file
@@ -17,6 +17,7 @@ Contains the methods of SceneManager class
 #include <timer.hpp>
 #include <debug_tools.hpp>
 #include <application.hpp>
+#include <job_system.hpp>
 
 jeBegin
 
@@ -78,6 +79,7 @@ void SceneManager::update(SDL_Event* event)
 
 			//currentTime = elapsedTime; // refresh the current time
 			currentScene_->update(frameTime_); // update the current scene
+			JobSystem::update(); // jobs bound to the main thread, mostly GL calls
 			SDL_GL_SwapWindow(window_);
 
 			InputHandler::mouse_refresh(*event); // refresh mouse wheel status
@@ -30,7 +30,7 @@ Sprite::~Sprite()
 
 void Sprite::add_to_system() 
 {
-	set_parent_renderer();
+	find_body();
 	GraphicSystem::add_renderer(this);
 }
 
@@ -49,9 +49,7 @@ void Sprite::draw(float /*dt*/)
 	Shader* shader = GraphicSystem::shader_[GraphicSystem::SPRITE];
 	shader->use();
 
-	shader->set_matrix("m4_translate", mat4::translate(transform_->position));
-	shader->set_matrix("m4_scale", mat4::scale(transform_->scale));
-	shader->set_matrix("m4_rotate", transform_->orientation.to_mat4());
+	shader->set_matrix("m4_model", get_render_matrix());
 	shader->set_bool("boolean_bilboard", (status & IS_BILBOARD) == IS_BILBOARD);
 	shader->set_bool("boolean_flip", (status & IS_FLIPPED) == IS_FLIPPED);
 	shader->set_vec4("v4_color", color);
@@ -94,16 +92,6 @@ void Sprite::draw(float /*dt*/)
 		shader->set_matrix("m4_viewport", viewport);
 	}
 
-	bool isHerited = parent_ != nullptr;
-	shader->set_bool("boolean_herited", isHerited);
-	if (isHerited)
-	{
-		Transform* pTransform = parent_->get_transform();
-		shader->set_matrix("m4_parentTranslate", mat4::translate(pTransform->position));
-		shader->set_matrix("m4_parentScale", mat4::scale(pTransform->scale));
-		shader->set_matrix("m4_parentRotate", pTransform->orientation.to_mat4());
-	}
-
 	bool isLighten = (status & IS_LIGHTEN) == IS_LIGHTEN;
 	shader->set_bool("boolean_lighten", isLighten);
 	if (isLighten)
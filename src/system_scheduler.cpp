@@ -0,0 +1,219 @@
+/******************************************************************************/
+/*!
+\file   system_scheduler.cpp
+\author Jeong Juyong
+\par    email: jaykop.jy\@gmail.com
+\date   2026/10/17(yy/mm/dd)
+
+\description
+Contains the methods of SystemScheduler and SystemNode class
+*/
+/******************************************************************************/
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <debug_tools.hpp>
+#include <system_scheduler.hpp>
+
+jeBegin
+
+using Clock = std::chrono::steady_clock;
+
+static Clock::time_point frameStart;
+
+static float elapsed_ms()
+{
+	return std::chrono::duration<float, std::milli>(Clock::now() - frameStart).count();
+}
+
+std::vector<SystemNode*> SystemScheduler::nodes_;
+bool SystemScheduler::built_ = false;
+float SystemScheduler::dt_ = 0.f, SystemScheduler::frameTime_ = 0.f;
+
+SystemNode& SystemNode::after(const char* name)
+{
+	after_.push_back(name);
+	SystemScheduler::built_ = false;
+	return *this;
+}
+
+SystemNode& SystemNode::on_main_thread()
+{
+	mainThread_ = true;
+	return *this;
+}
+
+SystemNode& SystemNode::exclusive()
+{
+	exclusive_ = true;
+	SystemScheduler::built_ = false;
+	return *this;
+}
+
+void SystemNode::add_type(Signature& types, unsigned id)
+{
+	auto found = std::lower_bound(types.begin(), types.end(), id);
+	if (found == types.end() || *found != id)
+		types.insert(found, id);
+
+	SystemScheduler::built_ = false;
+}
+
+bool SystemNode::conflicts(const SystemNode& other) const
+{
+	if (exclusive_ || other.exclusive_)
+		return true;
+
+	// both sorted, one pass over each pair of the lists
+	auto overlap = [](const Signature& lhs, const Signature& rhs) {
+		auto l = lhs.begin(), r = rhs.begin();
+		while (l != lhs.end() && r != rhs.end())
+		{
+			if (*l == *r)
+				return true;
+
+			if (*l < *r) ++l;
+			else ++r;
+		}
+		return false;
+	};
+
+	return overlap(writes_, other.writes_)
+		|| overlap(writes_, other.reads_)
+		|| overlap(reads_, other.writes_);
+}
+
+bool SystemNode::is_after(const char* name) const
+{
+	for (const char* a : after_)
+		if (!strcmp(a, name))
+			return true;
+
+	return false;
+}
+
+SystemNode& SystemScheduler::add_system(const char* name, const SystemNode::Update& update)
+{
+	nodes_.push_back(new SystemNode(name, update));
+	built_ = false;
+	return *nodes_.back();
+}
+
+void SystemScheduler::update(float dt)
+{
+	if (!built_)
+		build();
+
+	dt_ = dt;
+	frameStart = Clock::now();
+
+	// added in the order, so the counter of a dependency
+	// is already up when a later node asks for it
+	for (SystemNode* node : nodes_)
+		JobSystem::run([node]() { launch(node, 0); }, &node->done_);
+
+	for (SystemNode* node : nodes_)
+		JobSystem::wait(node->done_);
+
+	frameTime_ = elapsed_ms();
+}
+
+void SystemScheduler::clear()
+{
+	for (SystemNode* node : nodes_)
+		delete node;
+
+	nodes_.clear();
+	built_ = false;
+}
+
+void SystemScheduler::build()
+{
+	unsigned count = static_cast<unsigned>(nodes_.size());
+	std::vector<std::vector<bool>> ancestors(count, std::vector<bool>(count, false));
+
+	for (unsigned j = 0; j < count; ++j)
+	{
+		SystemNode* node = nodes_[j];
+		node->dependencies_.clear();
+		node->level_ = 0;
+
+		// only the earlier nodes, so the graph has no cycle.
+		// the latest first, what they already wait for is skipped
+		for (unsigned i = j; i-- > 0;)
+		{
+			if (ancestors[j][i]
+				|| !(nodes_[i]->conflicts(*node) || node->is_after(nodes_[i]->name_)))
+				continue;
+
+			node->dependencies_.push_back(i);
+			node->level_ = std::max(node->level_, nodes_[i]->level_ + 1);
+
+			ancestors[j][i] = true;
+			for (unsigned a = 0; a < i; ++a)
+				if (ancestors[i][a])
+					ancestors[j][a] = true;
+		}
+
+		for (const char* name : node->after_)
+		{
+			auto found = std::find_if(nodes_.begin(), nodes_.begin() + j,
+				[name](const SystemNode* n) { return !strcmp(n->name_, name); });
+			DEBUG_ASSERT(found != nodes_.begin() + j, "No such system added before!");
+			jeUnused(found);
+		}
+	}
+
+	built_ = true;
+}
+
+void SystemScheduler::launch(SystemNode* node, unsigned dependency)
+{
+	// one dependency at a time without blocking a worker,
+	// the next step is counted before this one is done
+	if (dependency < node->dependencies_.size()) {
+		SystemNode* before = nodes_[node->dependencies_[dependency]];
+		JobSystem::run_after(before->done_, [node, dependency]() {
+			launch(node, dependency + 1); }, &node->done_);
+		return;
+	}
+
+	if (node->mainThread_ && !JobSystem::is_main_thread() && JobSystem::get_thread_count() > 1)
+		JobSystem::run_on_main([node]() { execute(node); }, &node->done_);
+	else
+		execute(node);
+}
+
+void SystemScheduler::execute(SystemNode* node)
+{
+	node->thread_ = JobSystem::get_thread_index();
+	node->begin_ = elapsed_ms();
+	node->update_(dt_);
+	node->end_ = elapsed_ms();
+}
+
+void SystemScheduler::dump()
+{
+	if (!built_)
+		build();
+
+	printf("*SystemScheduler - %u systems, %.3f ms\n",
+		static_cast<unsigned>(nodes_.size()), frameTime_);
+	printf("  level thread    begin      end  system\n");
+
+	for (const SystemNode* node : nodes_)
+	{
+		printf("  %5u %6u %8.3f %8.3f  %s%s",
+			node->level_, node->thread_, node->begin_, node->end_,
+			node->name_, node->mainThread_ ? " (main)" : "");
+
+		for (unsigned i = 0; i < node->dependencies_.size(); ++i)
+			printf("%s%s", i ? ", " : " <- ", nodes_[node->dependencies_[i]]->name_);
+
+		printf("\n");
+	}
+}
+
+jeEnd
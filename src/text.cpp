@@ -57,7 +57,7 @@ Text::~Text()
 }
 void Text::add_to_system() 
 {
-	set_parent_renderer();
+	find_body();
 	GraphicSystem::add_renderer(this);
 }
 
@@ -124,16 +124,6 @@ void Text::draw(float /*dt*/)
 			shader->set_matrix("m4_viewport", viewport);
 		}
 
-		bool isHerited = parent_ != nullptr;
-		shader->set_bool("boolean_herited", isHerited);
-		if (isHerited)
-		{
-			Transform* pTransform = parent_->get_transform();
-			shader->set_matrix("m4_parentTranslate", mat4::translate(pTransform->position));
-			shader->set_matrix("m4_parentScale", mat4::scale(pTransform->scale));
-			shader->set_matrix("m4_parentRotate", pTransform->orientation.to_mat4());
-		}
-
 		glEnable(GL_BLEND);
 		glBlendFunc(sfactor_, dfactor_);
 		glEnable(GL_DEPTH_TEST);
@@ -1,4 +1,5 @@
 #include <transform.hpp>
+#include <transform_system.hpp>
 #include <math_util.hpp>
 
 using namespace Math;
@@ -12,8 +13,24 @@ Transform::Transform(Object* owner)
 	orientation(quat::identity)
 	, position(0.0f, 0.0f, 0.0f)
 	, scale(1.0f, 1.0f, 1.0f) 
+	, world_(mat4::identity)
 {}
 
+Transform::~Transform()
+{
+	remove_from_system();
+}
+
+void Transform::add_to_system()
+{
+	TransformSystem::add_transform(this);
+}
+
+void Transform::remove_from_system()
+{
+	TransformSystem::remove_transform(this);
+}
+
 vec3 Transform::rotation_euler_rad(void) const
 {
 	return orientation.get_euler();
@@ -26,20 +43,26 @@ vec3 Transform::rotation_euler_deg(void) const
 
 vec3 Transform::right(void)
 {
-	const mat4& m_to_w = model_to_world();
-	return vec3(m_to_w.m00, m_to_w.m10, m_to_w.m20);
+	// one column of the rotation, no need of the whole matrix
+	const mat3& rotation = orientation.to_mat3();
+	return vec3(rotation.m00, rotation.m10, rotation.m20) * scale.x;
 }
 
 vec3 Transform::up(void)
 {
-	const mat4& m_to_w = model_to_world();
-	return vec3(m_to_w.m01, m_to_w.m11, m_to_w.m21);
+	const mat3& rotation = orientation.to_mat3();
+	return vec3(rotation.m01, rotation.m11, rotation.m21) * scale.y;
 }
 
 vec3 Transform::forward(void)
 {
-	const mat4& m_to_w = model_to_world();
-	return vec3(m_to_w.m02, m_to_w.m12, m_to_w.m22);
+	const mat3& rotation = orientation.to_mat3();
+	return vec3(rotation.m02, rotation.m12, rotation.m22) * scale.z;
+}
+
+vec3 Transform::get_world_position(void) const
+{
+	return vec3(world_.m03, world_.m13, world_.m23);
 }
 
 void Transform::set_euler_rad(const vec3& rad)
@@ -65,6 +88,11 @@ void Transform::set_euler_deg(float deg_x, float deg_y, float deg_z)
 }
 
 mat4 Transform::model_to_world(void) const
+{
+	return compose(position, orientation, scale);
+}
+
+mat4 Transform::compose(const vec3& position, const quat& orientation, const vec3& scale)
 {
 	// combine rotation and translation
 	mat4 m_to_w = orientation.to_mat4();
@@ -72,15 +100,27 @@ mat4 Transform::model_to_world(void) const
 	m_to_w.m13 = position.y;
 	m_to_w.m23 = position.z;
 
-	// create scale mat
-	mat4 s(scale.x, 0.0f, 0.0f, 0.0f,
-		0.0f, scale.y, 0.0f, 0.0f,
-		0.0f, 0.0f, scale.z, 0.0f,
-		0.0f, 0.0f, 0.0f, 1.0f);
-
-	m_to_w *= s;
+	// scale the columns instead of multiplying a scale mat
+	m_to_w.m00 *= scale.x; m_to_w.m01 *= scale.y; m_to_w.m02 *= scale.z;
+	m_to_w.m10 *= scale.x; m_to_w.m11 *= scale.y; m_to_w.m12 *= scale.z;
+	m_to_w.m20 *= scale.x; m_to_w.m21 *= scale.y; m_to_w.m22 *= scale.z;
 
 	return m_to_w;
 }
 
+bool Transform::is_changed(void) const
+{
+	return cachedPosition_ != position
+		|| cachedScale_ != scale
+		|| cachedOrientation_ != orientation;
+}
+
+void Transform::cache_local(void)
+{
+	cachedPosition_ = position;
+	cachedScale_ = scale;
+	cachedOrientation_ = orientation;
+	dirty_ = false;
+}
+
 jeEnd
\ No newline at end of file
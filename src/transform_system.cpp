@@ -0,0 +1,227 @@
+/******************************************************************************/
+/*!
+\file   transform_system.cpp
+\author Jeong Juyong
+\par    email: jaykop.jy\@gmail.com
+\date   2026/10/17(yy/mm/dd)
+
+\description
+Contains the methods of TransformSystem class
+*/
+/******************************************************************************/
+
+#include <transform_system.hpp>
+#include <transform.hpp>
+#include <object.hpp>
+#include <object_manager.hpp>
+
+jeBegin
+
+TransformSystem::Transforms TransformSystem::transforms_, TransformSystem::order_;
+std::vector<int> TransformSystem::parents_;
+std::vector<char> TransformSystem::moved_;
+bool TransformSystem::sorted_ = false;
+std::stack<TransformSystem::Hierarchy> TransformSystem::hierarchyStack_;
+
+void TransformSystem::initialize()
+{
+	sorted_ = false;
+}
+
+void TransformSystem::update(float /*dt*/)
+{
+	if (!sorted_)
+		sort();
+
+	for (unsigned i = 0; i < order_.size(); ++i)
+	{
+		Transform* transform = order_[i];
+		int parent = parents_[i];
+
+		// a moved parent moves the whole subtree
+		bool dirty = transform->dirty_ || transform->is_changed()
+			|| (parent >= 0 && moved_[parent]);
+
+		moved_[i] = dirty;
+		if (!dirty)
+			continue;
+
+		transform->cache_local();
+		transform->world_ = parent >= 0
+			? order_[parent]->world_ * transform->model_to_world()
+			: transform->model_to_world();
+	}
+}
+
+void TransformSystem::close()
+{
+	for (const auto& t : transforms_)
+	{
+		t->index_ = -1;
+		t->parent_ = nullptr;
+		t->childCount_ = 0;
+	}
+
+	transforms_.clear();
+	order_.clear();
+	parents_.clear();
+	moved_.clear();
+	sorted_ = false;
+}
+
+void TransformSystem::pause()
+{
+	Hierarchy hierarchy;
+	hierarchy.transforms.swap(transforms_);
+	hierarchy.order.swap(order_);
+	hierarchy.parents.swap(parents_);
+	hierarchy.sorted = sorted_;
+
+	hierarchyStack_.emplace(std::move(hierarchy));
+
+	// the indices of the paused transforms stay valid in the saved list
+	moved_.clear();
+	sorted_ = false;
+}
+
+void TransformSystem::resume()
+{
+	if (!hierarchyStack_.empty())
+	{
+		Hierarchy& hierarchy = hierarchyStack_.top();
+		transforms_.swap(hierarchy.transforms);
+		order_.swap(hierarchy.order);
+		parents_.swap(hierarchy.parents);
+		moved_.assign(order_.size(), 0);
+		sorted_ = hierarchy.sorted;
+
+		hierarchyStack_.pop();
+	}
+}
+
+void TransformSystem::add_transform(Transform* transform)
+{
+	if (transform->index_ >= 0)
+		return;
+
+	transform->index_ = static_cast<int>(transforms_.size());
+	transforms_.push_back(transform);
+	link(transform);
+
+	// the children may have joined before their parent
+	for (const auto& child : transform->get_owner()->children_)
+	{
+		Object* object = ObjectManager::get_object(child);
+		if (object && object->has_component<Transform>()
+			&& object->get_component<Transform>()->index_ >= 0)
+			link(object->get_component<Transform>());
+	}
+}
+
+void TransformSystem::remove_transform(Transform* transform)
+{
+	int index = transform->index_;
+	if (index < 0)
+		return;
+
+	// the children become roots, keeping their local values
+	for (unsigned i = 0; transform->childCount_ && i < transforms_.size(); ++i)
+	{
+		Transform* child = transforms_[i];
+		if (child->parent_ == transform) {
+			child->parent_ = nullptr;
+			child->dirty_ = true;
+			--transform->childCount_;
+		}
+	}
+
+	if (transform->parent_)
+		--transform->parent_->childCount_;
+
+	transforms_[index] = transforms_.back();
+	transforms_[index]->index_ = index;
+	transforms_.pop_back();
+
+	transform->index_ = -1;
+	transform->parent_ = nullptr;
+	sorted_ = false;
+}
+
+void TransformSystem::update_parent(Object* object)
+{
+	// linked when it joins the system otherwise
+	if (object->has_component<Transform>()
+		&& object->get_component<Transform>()->index_ >= 0)
+		link(object->get_component<Transform>());
+}
+
+void TransformSystem::link(Transform* transform)
+{
+	Object* parentObject = transform->get_owner()->get_parent();
+	Transform* parent = parentObject && parentObject->has_component<Transform>()
+		? parentObject->get_component<Transform>() : nullptr;
+
+	if (parent && parent->index_ < 0)
+		parent = nullptr;
+
+	if (transform->parent_)
+		--transform->parent_->childCount_;
+
+	if (parent)
+		++parent->childCount_;
+
+	transform->parent_ = parent;
+	transform->dirty_ = true;
+	sorted_ = false;
+}
+
+void TransformSystem::sort()
+{
+	unsigned count = static_cast<unsigned>(transforms_.size());
+
+	// children of each transform in one array, grouped by the parent
+	std::vector<unsigned> first(count + 1, 0), children(count);
+	for (const auto& t : transforms_)
+		if (t->parent_)
+			++first[t->parent_->index_ + 1];
+
+	for (unsigned i = 0; i < count; ++i)
+		first[i + 1] += first[i];
+
+	std::vector<unsigned> next(first.begin(), first.end() - 1);
+	for (unsigned i = 0; i < count; ++i)
+		if (transforms_[i]->parent_)
+			children[next[transforms_[i]->parent_->index_]++] = i;
+
+	order_.clear();
+	parents_.clear();
+
+	// depth first from every root, the stack holds the index in the transforms
+	// and the position of the parent in the order
+	std::vector<std::pair<unsigned, int>> stack;
+	for (unsigned root = 0; root < count; ++root)
+	{
+		if (transforms_[root]->parent_)
+			continue;
+
+		stack.emplace_back(root, -1);
+		while (!stack.empty())
+		{
+			std::pair<unsigned, int> top = stack.back();
+			stack.pop_back();
+
+			int position = static_cast<int>(order_.size());
+			order_.push_back(transforms_[top.first]);
+			parents_.push_back(top.second);
+
+			// reversed, so the first child comes out first
+			for (unsigned c = first[top.first + 1]; c-- > first[top.first];)
+				stack.emplace_back(children[c], position);
+		}
+	}
+
+	moved_.assign(order_.size(), 0);
+	sorted_ = true;
+}
+
+jeEnd